@@ -0,0 +1,72 @@
+#ifndef s28_bench_bench_h
+#define s28_bench_bench_h
+
+#include <stdio.h>
+
+#include <chrono>
+
+#include "alloc_stats.h"
+
+namespace s28 {
+namespace bench {
+
+struct Result {
+  size_t iterations;
+  size_t allocs;
+  size_t bytes;
+};
+
+// benchmarks that broke an expectation, main() returns non-zero then
+inline int &failures() {
+  static int n = 0;
+  return n;
+}
+
+// Runs fn repeatedly for about `budget_ms` and prints ns/op together with
+// the heap allocations and bytes per call.
+template <typename Fn>
+Result run(const char *name, Fn fn, int budget_ms = 200) {
+  using clock = std::chrono::steady_clock;
+
+  fn(); // warm up, lazy initialization must not count
+
+  size_t iterations = 0;
+  alloc_stats::Counters before = alloc_stats::counters();
+  auto start = clock::now();
+  auto deadline = start + std::chrono::milliseconds(budget_ms);
+  auto now = start;
+  do {
+    for (int i = 0; i < 16; ++i) {
+      fn();
+    }
+    iterations += 16;
+    now = clock::now();
+  } while (now < deadline);
+  alloc_stats::Counters after = alloc_stats::counters();
+
+  double ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+  printf("%-32s %10zu %12.1f %10.2f %12.1f\n", name, iterations,
+         ns / iterations, double(after.allocs - before.allocs) / iterations,
+         double(after.bytes - before.bytes) / iterations);
+  return {iterations, after.allocs - before.allocs,
+          after.bytes - before.bytes};
+}
+
+// run() for a path that must not touch the heap
+template <typename Fn> void run_no_alloc(const char *name, Fn fn) {
+  if (run(name, fn).allocs) {
+    printf("FAIL: %s allocates\n", name);
+    ++failures();
+  }
+}
+
+inline void header() {
+  printf("%-32s %10s %12s %10s %12s\n", "benchmark", "iterations", "ns/op",
+         "allocs/op", "bytes/op");
+}
+
+} // namespace bench
+} // namespace s28
+
+#endif
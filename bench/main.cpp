@@ -0,0 +1,259 @@
+// Host benchmarks of the firmware hot paths. Exits non-zero when a path
+// checked with run_no_alloc() starts allocating. Build and run with
+//   pio run -e native && .pio/build/native/program
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "alloc_stats.h"
+#include "apps/config/page.h"
+#include "args.h"
+#include "bench.h"
+#include "histogram.h"
+#include "log_store.h"
+#include "logging.h"
+#include "lz.h"
+#include "metrics.h"
+#include "profiler.h"
+#include "rtc_mem.h"
+#include "scheduler.h"
+#include "sink.h"
+#include "utils.h"
+
+using namespace s28;
+
+S28_LOG_MODULE(MAIN, "bench")
+
+S28_PROFILE_SPAN(bench_span, "bench.empty");
+
+namespace {
+
+#include "apps/config/setup_html.h"
+
+StartupArgs sample_args() {
+  StartupArgs args;
+  args.flags = "0";
+  args.ssid = "home-network <5GHz>";
+  args.password = "correct horse battery staple";
+  args.collector = "192.168.1.10";
+  args.token = "4a9f0c3e7d2b41f6a8c5e9d07b3f1a26";
+  args.fingerprint = "A1 B2 C3 D4 E5 F6 07 18 29 3A 4B 5C 6D 7E 8F 90 A1 B2 "
+                     "C3 D4";
+  args.ok = true;
+  return args;
+}
+
+struct MapArgs : public IArgsMap {
+  const char *get(const char *name) override {
+    auto it = values.find(name);
+    if (it == values.end()) {
+      return nullptr;
+    }
+    return it->second.c_str();
+  }
+  std::map<std::string, std::string> values;
+};
+
+// stands in for the http response: consumes the chunks like sendContent
+struct BenchResponse : public ChunkPrint {
+  BenchResponse() : ChunkPrint(buf, sizeof(buf)) {}
+  void send(const char *data, size_t n) override { sent += n; }
+  char buf[256];
+  size_t sent = 0;
+};
+
+// renders like AppConfig does
+struct BenchPageOutput : public app_config::PageOutput {
+  void literal(const unsigned char *data, size_t len) override {
+    out.flush();
+    out.sent += len;
+  }
+
+  void var(char c) override {
+    switch (c) {
+    case 'F':
+      gen_html_form_content(out, &args);
+      break;
+    case 'n':
+      for (int i = 0; i < networks; ++i) {
+        char ssid[24];
+        snprintf(ssid, sizeof(ssid), "network-%d", i);
+        out.print("<p><a href=\"javascript:setSsid('");
+        utils::escape_html(out, ssid);
+        out.print("')\">");
+        utils::escape_html(out, ssid);
+        out.print("</a></p>");
+      }
+      break;
+    }
+  }
+
+  StartupArgs args = sample_args();
+  int networks = 10;
+  BenchResponse out;
+};
+
+} // namespace
+
+int main() {
+  alloc_stats::phase("start");
+  bench::header();
+
+  {
+    StartupArgs args = sample_args();
+    bench::run("write_startup_args", [&]() { write_startup_args(&args); });
+    bench::run_no_alloc("read_startup_args/warm",
+                        [&]() { read_startup_args(&args); });
+    bench::run("read_startup_args/cold", [&]() {
+      rtc_mem::invalidate(rtc_mem::CONFIG);
+      read_startup_args(&args);
+    });
+    String json;
+    export_startup_args_json(&args, json);
+    bench::run("import_startup_args_json", [&]() {
+      import_startup_args_json(json.c_str(), &args);
+    });
+  }
+
+  {
+    MapArgs m;
+    m.values = {{"ssid", "home-network"},
+                {"password", "correct horse battery staple"},
+                {"collector", "192.168.1.10"},
+                {"token", "4a9f0c3e7d2b41f6a8c5e9d07b3f1a26"},
+                {"fingerprint", ""}};
+    StartupArgs args;
+    bench::run_no_alloc("update_startup_args",
+                        [&]() { update_startup_args(m, &args); });
+  }
+
+  {
+    StartupArgs args = sample_args();
+    char buf[2048];
+    bench::run_no_alloc("gen_html_form_content", [&]() {
+      BoundedPrint out(buf, sizeof(buf));
+      gen_html_form_content(out, &args);
+    });
+  }
+
+  {
+    const char *plain = "a perfectly ordinary wifi network name";
+    const char *markup = "<script>alert(\"it's & more\")</script>";
+    char buf[128];
+    bench::run_no_alloc("escape_html/plain", [&]() {
+      BoundedPrint out(buf, sizeof(buf));
+      utils::escape_html(out, plain);
+    });
+    bench::run_no_alloc("escape_html/markup", [&]() {
+      BoundedPrint out(buf, sizeof(buf));
+      utils::escape_html(out, markup);
+    });
+  }
+
+  {
+    bench::run_no_alloc("log/short", []() { log("event: %d", 1); });
+    bench::run("log/long", []() {
+      log("WiFi connected, Gateway Ip: %s, attempt %d of %d, rssi %d dBm",
+          "192.168.100.1", 3, 15, -71);
+    });
+    bench::run_no_alloc("log/LOGI", []() { LOGI("event: %d", 1); });
+    // compiled out unless S28_LOG_LEVEL is 0
+    bench::run("log/LOGD", []() { LOGD("key: [%s] has good type", "ssid"); });
+  }
+
+  {
+    uint8_t block[log_store::BLOCK_SIZE];
+    size_t n = 0;
+    for (int i = 0; n + 64 < sizeof(block); ++i) {
+      n += snprintf((char *)block + n, sizeof(block) - n,
+                    "D s26: wifi not connected, retry %d\n", i);
+    }
+    uint8_t packed[sizeof(block)];
+    size_t packed_len = 0;
+    bench::run("lz/compress", [&]() {
+      packed_len = lz::compress(block, n, packed, sizeof(packed));
+    });
+    printf("  lz ratio: %zu -> %zu bytes\n", n, packed_len);
+  }
+
+  {
+    app_config::Page page;
+    bench::run("page/parse", [&]() {
+      page.parse(assets_setup_html, assets_setup_html_len);
+    });
+    BenchPageOutput out;
+    bench::run_no_alloc("page/render", [&]() { page.render(out); });
+  }
+
+  {
+    // loop overhead with nothing due, then with every task due
+    std::vector<std::unique_ptr<scheduler::FnTask>> tasks;
+    for (int i = 0; i < 8; ++i) {
+      tasks.emplace_back(new scheduler::FnTask("bench", [] { return 1000; }));
+      scheduler::add(tasks.back().get(), 1000);
+    }
+    bench::run_no_alloc("scheduler/idle", []() { scheduler::loop(); });
+    for (auto &t : tasks) {
+      t->fn = [] { return 0; };
+      scheduler::add(t.get());
+    }
+    bench::run_no_alloc("scheduler/8_due", []() { scheduler::loop(); });
+  }
+
+  {
+    // recording a sample must stay cheap enough for the relay handler
+    Histogram h;
+    uint32_t v = 1;
+    bench::run("histogram/add", [&]() { h.add(v = v * 1103515245 + 12345); });
+    bench::run("histogram/p99", [&]() { v += h.percentile(990); });
+  }
+
+  {
+    // a /metrics scrape, family by family through the server's chunk
+    metrics::Sample s = {};
+    s.free_heap = 31000;
+    s.rssi = -67;
+    s.tls_full = {3, 2400, 900, 850};
+    char buf[metrics::MAX_FAMILY_LEN];
+    bench::run_no_alloc("metrics/render", [&]() {
+      for (size_t i = 0; i < metrics::FAMILY_COUNT; ++i) {
+        metrics::render_family(s, i, buf, sizeof(buf));
+      }
+    });
+
+    // the widest values must fit as well
+    uint32_t max = 0xffffffff;
+    s = {max, max, max, max, max, max, INT32_MIN, max, max,
+         {max, max, max, max}, {max, max, max, max}};
+    size_t total = 0;
+    for (size_t i = 0; i < metrics::FAMILY_COUNT; ++i) {
+      size_t n = metrics::render_family(s, i, buf, sizeof(buf));
+      if (!n) {
+        printf("FAIL: metric family %zu does not fit into %zu bytes\n", i,
+               sizeof(buf));
+        ++bench::failures();
+      }
+      total += n;
+    }
+    printf("  metrics worst case: %zu bytes\n", total);
+  }
+
+  // cost of an empty span, the device adds it to every instrumented call
+  bench::run("profiler/scope", []() { S28_PROFILE_SCOPE(bench_span); });
+
+  utils::FsStats fs = utils::fs_stats();
+  printf("LittleFS: %zu mount(s) for %u opens\n", LittleFS.mount_count(),
+         unsigned(fs.opens));
+
+  // the same spans as on the device (args.write), to compare with "prof"
+  Serial.echo(true);
+  profiler::dump(Serial);
+  alloc_stats::phase("benchmarks");
+  alloc_stats::dump(Serial);
+  return bench::failures() ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "user_interface.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+const auto boot_time = std::chrono::steady_clock::now();
+} // namespace
+
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - boot_time)
+      .count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - boot_time)
+      .count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {}
+
+namespace {
+rst_info reset_info = {REASON_SOFT_RESTART, 0, 0, 0, 0, 0, 0};
+uint32_t rtc_user_memory[128];
+} // namespace
+
+rst_info *EspClass::getResetInfoPtr() { return &reset_info; }
+
+String EspClass::getResetReason() { return String("Software/System restart"); }
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data,
+                                 size_t size) {
+  if (offset * 4 + size > sizeof(rtc_user_memory)) {
+    return false;
+  }
+  memcpy(data, rtc_user_memory + offset, size);
+  return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data,
+                                  size_t size) {
+  if (offset * 4 + size > sizeof(rtc_user_memory)) {
+    return false;
+  }
+  memcpy(rtc_user_memory + offset, data, size);
+  return true;
+}
+
+uint32_t EspClass::getCycleCount() {
+  // an 80 MHz clock, wrapping like the device's
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - boot_time)
+                .count();
+  return uint32_t(uint64_t(ns) * 80 / 1000);
+}
+
+uint32_t EspClass::getFreeHeap() { return 0; }
+
+void EspClass::reset() { exit(0); }
+
+void EspClass::restart() { exit(0); }
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (!write(*buffer++)) {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  char tmp[64];
+  char *buffer = tmp;
+  size_t len = vsnprintf(tmp, sizeof(tmp), format, arg);
+  va_end(arg);
+  if (len > sizeof(tmp) - 1) {
+    buffer = new char[len + 1];
+    va_start(arg, format);
+    vsnprintf(buffer, len + 1, format, arg);
+    va_end(arg);
+  }
+  len = write((const uint8_t *)buffer, len);
+  if (buffer != tmp) {
+    delete[] buffer;
+  }
+  return len;
+}
+
+size_t Print::print(const String &s) { return write(s.c_str(), s.length()); }
+
+size_t Print::print(int n) { return printf("%d", n); }
+
+size_t Print::print(unsigned int n) { return printf("%u", n); }
+
+size_t Print::print(long n) { return printf("%ld", n); }
+
+size_t Print::print(unsigned long n) { return printf("%lu", n); }
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  written += size;
+  if (echo_) {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
@@ -0,0 +1,45 @@
+#ifndef s28_native_arduino_h
+#define s28_native_arduino_h
+
+// Minimal Arduino API for the host (native) build. Only the parts used by
+// the portable firmware modules (args, logging, utils, config page) are
+// provided.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+#include <memory>
+
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define vsnprintf_P vsnprintf
+#define snprintf_P snprintf
+#define F(s) (s)
+#define ICACHE_RAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define LED_BUILTIN 2
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef s28_native_esp_h
+#define s28_native_esp_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "WString.h"
+
+struct rst_info;
+
+// The host behaves like a device after a soft restart: the RTC user memory
+// is emulated and kept for the lifetime of the process.
+class EspClass {
+public:
+  rst_info *getResetInfoPtr();
+  String getResetReason();
+  bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+  bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+  uint32_t getCycleCount();
+  uint8_t getCpuFreqMHz() { return 80; }
+  uint32_t getFreeHeap();
+  void reset();
+  void restart();
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,138 @@
+#include "FS.h"
+#include "LittleFS.h"
+
+fs::FS LittleFS;
+
+namespace fs {
+
+size_t File::write(const uint8_t *buf, size_t size) {
+  if (!data || !writable) {
+    return 0;
+  }
+  if (pos + size > data->size()) {
+    data->resize(pos + size);
+  }
+  memcpy(data->data() + pos, buf, size);
+  pos += size;
+  return size;
+}
+
+int File::available() {
+  if (!data) {
+    return 0;
+  }
+  return data->size() - pos;
+}
+
+int File::read() {
+  uint8_t c;
+  if (read(&c, 1) != 1) {
+    return -1;
+  }
+  return c;
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+  if (!data || pos >= data->size()) {
+    return 0;
+  }
+  if (size > data->size() - pos) {
+    size = data->size() - pos;
+  }
+  memcpy(buf, data->data() + pos, size);
+  pos += size;
+  return size;
+}
+
+bool File::seek(uint32_t p, SeekMode mode) {
+  if (!data) {
+    return false;
+  }
+  switch (mode) {
+  case SeekSet:
+    break;
+  case SeekCur:
+    p += pos;
+    break;
+  case SeekEnd:
+    p += data->size();
+    break;
+  }
+  if (p > data->size()) {
+    return false;
+  }
+  pos = p;
+  return true;
+}
+
+bool FS::begin() {
+  mounted = true;
+  mounts++;
+  return true;
+}
+
+void FS::end() { mounted = false; }
+
+bool FS::format() {
+  files.clear();
+  return true;
+}
+
+bool FS::info(FSInfo &info) {
+  size_t used = 0;
+  for (auto &f : files) {
+    used += f.second->size();
+  }
+  info.totalBytes = 1024 * 1024;
+  info.usedBytes = used;
+  info.blockSize = 8192;
+  info.pageSize = 256;
+  info.maxOpenFiles = 5;
+  info.maxPathLength = 32;
+  return true;
+}
+
+File FS::open(const char *path, const char *mode) {
+  if (!mounted) {
+    return File();
+  }
+  auto it = files.find(path);
+  if (mode[0] == 'r') {
+    if (it == files.end()) {
+      return File();
+    }
+    return File(it->second, mode[1] == '+');
+  }
+  if (it == files.end() || mode[0] == 'w') {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    files[path] = data;
+    return File(data, true);
+  }
+  // append
+  File f(it->second, true);
+  f.seek(0, SeekEnd);
+  return f;
+}
+
+bool FS::exists(const char *path) {
+  return mounted && files.find(path) != files.end();
+}
+
+bool FS::remove(const char *path) {
+  return mounted && files.erase(path) > 0;
+}
+
+bool FS::rename(const char *from, const char *to) {
+  if (!mounted) {
+    return false;
+  }
+  auto it = files.find(from);
+  if (it == files.end()) {
+    return false;
+  }
+  files[to] = it->second;
+  files.erase(from);
+  return true;
+}
+
+} // namespace fs
@@ -0,0 +1,87 @@
+#ifndef s28_native_fs_h
+#define s28_native_fs_h
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+// In-memory file. The contents live in the owning FS so they survive
+// close/open cycles the same way they survive on flash.
+class File : public Print {
+public:
+  File() {}
+  File(std::shared_ptr<std::vector<uint8_t>> data, bool writable)
+      : data(data), writable(writable) {}
+
+  using Print::write;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+
+  int available();
+  int read();
+  size_t read(uint8_t *buf, size_t size);
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const { return pos; }
+  size_t size() const { return data ? data->size() : 0; }
+  void flush() override {}
+  void close() { data.reset(); }
+
+  operator bool() const { return data != nullptr; }
+
+private:
+  std::shared_ptr<std::vector<uint8_t>> data;
+  bool writable = false;
+  size_t pos = 0;
+};
+
+struct FSInfo {
+  size_t totalBytes;
+  size_t usedBytes;
+  size_t blockSize;
+  size_t pageSize;
+  size_t maxOpenFiles;
+  size_t maxPathLength;
+};
+
+class FS {
+public:
+  bool begin();
+  void end();
+  bool format();
+  bool info(FSInfo &info);
+
+  File open(const char *path, const char *mode);
+  File open(const String &path, const char *mode) {
+    return open(path.c_str(), mode);
+  }
+  bool exists(const char *path);
+  bool remove(const char *path);
+  bool rename(const char *from, const char *to);
+
+  // host only: number of begin() calls, the benchmarks report it
+  size_t mount_count() const { return mounts; }
+
+private:
+  bool mounted = false;
+  size_t mounts = 0;
+  std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::FSInfo;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef s28_native_hardware_serial_h
+#define s28_native_hardware_serial_h
+
+#include "Print.h"
+
+// Serial output is dropped by default so the benchmarks measure the
+// firmware code and not the terminal; echo(true) forwards it to stdout.
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void echo(bool b) { echo_ = b; }
+  size_t bytes_written() const { return written; }
+
+  int available() { return 0; }
+  int read() { return -1; }
+
+  using Print::write;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+
+private:
+  bool echo_ = false;
+  size_t written = 0;
+};
+
+extern HardwareSerial Serial;
+
+#endif
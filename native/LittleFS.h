@@ -0,0 +1,8 @@
+#ifndef s28_native_littlefs_h
+#define s28_native_littlefs_h
+
+#include "FS.h"
+
+extern fs::FS LittleFS;
+
+#endif
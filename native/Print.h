@@ -0,0 +1,46 @@
+#ifndef s28_native_print_h
+#define s28_native_print_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class String;
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+
+  size_t write(const char *str) {
+    if (!str) {
+      return 0;
+    }
+    return write((const uint8_t *)str, strlen(str));
+  }
+  size_t write(const char *buffer, size_t size) {
+    return write((const uint8_t *)buffer, size);
+  }
+
+  size_t printf(const char *format, ...)
+      __attribute__((format(printf, 2, 3)));
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s);
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int n);
+  size_t print(unsigned int n);
+  size_t print(long n);
+  size_t print(unsigned long n);
+
+  size_t println() { return write("\r\n"); }
+  size_t println(const char *s) { return print(s) + println(); }
+  size_t println(const String &s) { return print(s) + println(); }
+  size_t println(int n) { return print(n) + println(); }
+
+  virtual void flush() {}
+};
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef s28_native_software_serial_h
+#define s28_native_software_serial_h
+
+#include "Arduino.h"
+
+#endif
@@ -0,0 +1,244 @@
+#include "WString.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void String::init() {
+  sso_ = true;
+  len_ = 0;
+  cap_ = SSO_CAPACITY;
+  heap_buf = nullptr;
+  sso_buf[0] = 0;
+}
+
+void String::invalidate() {
+  if (!sso_) {
+    free(heap_buf);
+  }
+  init();
+}
+
+bool String::change_buffer(size_t max_len) {
+  if (max_len <= SSO_CAPACITY && sso_) {
+    return true;
+  }
+  if (sso_) {
+    char *p = (char *)malloc(max_len + 1);
+    if (!p) {
+      return false;
+    }
+    memcpy(p, sso_buf, len_ + 1);
+    heap_buf = p;
+    sso_ = false;
+  } else {
+    char *p = (char *)realloc(heap_buf, max_len + 1);
+    if (!p) {
+      return false;
+    }
+    heap_buf = p;
+  }
+  cap_ = max_len;
+  return true;
+}
+
+bool String::reserve(size_t size) {
+  if (size <= cap_) {
+    return true;
+  }
+  return change_buffer(size);
+}
+
+String::String(const char *cstr) {
+  init();
+  if (cstr) {
+    concat(cstr, strlen(cstr));
+  }
+}
+
+String::String(const char *cstr, size_t len) {
+  init();
+  concat(cstr, len);
+}
+
+String::String(const String &s) {
+  init();
+  concat(s.c_str(), s.length());
+}
+
+String::String(String &&s) {
+  init();
+  *this = static_cast<String &&>(s);
+}
+
+String::String(char c) {
+  init();
+  concat(&c, 1);
+}
+
+String::String(int n) {
+  init();
+  concat(n);
+}
+
+String::String(unsigned int n) {
+  init();
+  concat(n);
+}
+
+String::String(long n) {
+  init();
+  char tmp[24];
+  snprintf(tmp, sizeof(tmp), "%ld", n);
+  concat(tmp);
+}
+
+String::String(unsigned long n) {
+  init();
+  char tmp[24];
+  snprintf(tmp, sizeof(tmp), "%lu", n);
+  concat(tmp);
+}
+
+String::~String() { invalidate(); }
+
+String &String::operator=(const String &rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  len_ = 0;
+  wbuffer()[0] = 0;
+  concat(rhs.c_str(), rhs.length());
+  return *this;
+}
+
+String &String::operator=(String &&rhs) {
+  if (this == &rhs) {
+    return *this;
+  }
+  invalidate();
+  if (rhs.sso_) {
+    memcpy(sso_buf, rhs.sso_buf, rhs.len_ + 1);
+    len_ = rhs.len_;
+  } else {
+    sso_ = false;
+    heap_buf = rhs.heap_buf;
+    len_ = rhs.len_;
+    cap_ = rhs.cap_;
+    rhs.init();
+  }
+  return *this;
+}
+
+String &String::operator=(const char *cstr) {
+  len_ = 0;
+  wbuffer()[0] = 0;
+  if (cstr) {
+    concat(cstr, strlen(cstr));
+  }
+  return *this;
+}
+
+bool String::concat(const char *cstr) {
+  if (!cstr) {
+    return false;
+  }
+  return concat(cstr, strlen(cstr));
+}
+
+bool String::concat(const char *cstr, size_t len) {
+  if (!cstr) {
+    return false;
+  }
+  if (len == 0) {
+    return true;
+  }
+  size_t new_len = len_ + len;
+  if (!reserve(new_len)) {
+    return false;
+  }
+  memmove(wbuffer() + len_, cstr, len);
+  len_ = new_len;
+  wbuffer()[len_] = 0;
+  return true;
+}
+
+bool String::concat(int n) {
+  char tmp[16];
+  snprintf(tmp, sizeof(tmp), "%d", n);
+  return concat(tmp);
+}
+
+bool String::concat(unsigned int n) {
+  char tmp[16];
+  snprintf(tmp, sizeof(tmp), "%u", n);
+  return concat(tmp);
+}
+
+bool String::equals(const char *cstr) const {
+  if (!cstr) {
+    return len_ == 0;
+  }
+  return strcmp(c_str(), cstr) == 0;
+}
+
+char String::operator[](unsigned int index) const {
+  if (index >= len_) {
+    return 0;
+  }
+  return c_str()[index];
+}
+
+char &String::operator[](unsigned int index) {
+  static char dummy_writable_char;
+  if (index >= len_) {
+    dummy_writable_char = 0;
+    return dummy_writable_char;
+  }
+  return wbuffer()[index];
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= len_) {
+    return -1;
+  }
+  const char *p = strchr(c_str() + from, c);
+  if (!p) {
+    return -1;
+  }
+  return p - c_str();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int tmp = from;
+    from = to;
+    to = tmp;
+  }
+  if (from >= len_) {
+    return String();
+  }
+  if (to > len_) {
+    to = len_;
+  }
+  return String(c_str() + from, to - from);
+}
+
+long String::atol_(const char *s) { return atol(s); }
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  a.concat(rhs);
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  a.concat(cstr);
+  return a;
+}
+
+StringSumHelper &operator+(const StringSumHelper &lhs, char c) {
+  StringSumHelper &a = const_cast<StringSumHelper &>(lhs);
+  a.concat(c);
+  return a;
+}
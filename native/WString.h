@@ -0,0 +1,89 @@
+#ifndef s28_native_wstring_h
+#define s28_native_wstring_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Host stand-in for the Arduino String. It keeps the ESP8266 core's
+// allocation behaviour (11 byte SSO buffer, realloc on growth) so the
+// allocation counts reported by the benchmarks match the device.
+class String {
+public:
+  String() { init(); }
+  String(const char *cstr);
+  String(const char *cstr, size_t len);
+  String(const String &s);
+  String(String &&s);
+  explicit String(char c);
+  explicit String(int n);
+  explicit String(unsigned int n);
+  explicit String(long n);
+  explicit String(unsigned long n);
+  ~String();
+
+  String &operator=(const String &rhs);
+  String &operator=(String &&rhs);
+  String &operator=(const char *cstr);
+
+  bool reserve(size_t size);
+  unsigned int length() const { return len_; }
+  bool isEmpty() const { return len_ == 0; }
+  const char *c_str() const { return sso_ ? sso_buf : heap_buf; }
+  char *begin() { return (char *)c_str(); }
+  char *end() { return begin() + len_; }
+
+  bool concat(const String &s) { return concat(s.c_str(), s.length()); }
+  bool concat(const char *cstr);
+  bool concat(const char *cstr, size_t len);
+  bool concat(char c) { return concat(&c, 1); }
+  bool concat(int n);
+  bool concat(unsigned int n);
+
+  String &operator+=(const String &rhs) { concat(rhs); return *this; }
+  String &operator+=(const char *cstr) { concat(cstr); return *this; }
+  String &operator+=(char c) { concat(c); return *this; }
+  String &operator+=(int n) { concat(n); return *this; }
+  String &operator+=(unsigned int n) { concat(n); return *this; }
+
+  bool equals(const char *cstr) const;
+  bool operator==(const String &rhs) const { return equals(rhs.c_str()); }
+  bool operator==(const char *cstr) const { return equals(cstr); }
+  bool operator!=(const String &rhs) const { return !equals(rhs.c_str()); }
+  bool operator!=(const char *cstr) const { return !equals(cstr); }
+
+  char operator[](unsigned int index) const;
+  char &operator[](unsigned int index);
+
+  int indexOf(char c, unsigned int from = 0) const;
+  String substring(unsigned int from, unsigned int to) const;
+  long toInt() const { return atol_(c_str()); }
+
+private:
+  static constexpr size_t SSO_CAPACITY = 11;
+
+  static long atol_(const char *s);
+  void init();
+  void invalidate();
+  bool change_buffer(size_t max_len);
+  char *wbuffer() { return sso_ ? sso_buf : heap_buf; }
+
+  bool sso_;
+  unsigned int len_;
+  unsigned int cap_;
+  char *heap_buf;
+  char sso_buf[SSO_CAPACITY + 1];
+};
+
+class StringSumHelper : public String {
+public:
+  StringSumHelper(const String &s) : String(s) {}
+  StringSumHelper(const char *p) : String(p) {}
+  StringSumHelper(char c) : String(c) {}
+};
+
+StringSumHelper &operator+(const StringSumHelper &lhs, const String &rhs);
+StringSumHelper &operator+(const StringSumHelper &lhs, const char *cstr);
+StringSumHelper &operator+(const StringSumHelper &lhs, char c);
+
+#endif
@@ -0,0 +1,279 @@
+#include "alloc_stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef S28_NATIVE
+#include <malloc.h>
+#else
+#include <new>
+#endif
+
+namespace s28 {
+namespace alloc_stats {
+
+namespace {
+
+Counters current;
+Phase phases[MAX_PHASES];
+int phase_count = 0;
+
+void allocated(void *p, size_t size) {
+  current.allocs++;
+  current.bytes += size;
+  if (!p && size) {
+    current.failed++;
+  }
+}
+
+#ifdef S28_NATIVE
+
+void update_live(void *p, bool add) {
+  if (!p) {
+    return;
+  }
+  size_t n = malloc_usable_size(p);
+  if (add) {
+    current.live += n;
+    if (current.live > current.peak) {
+      current.peak = current.live;
+    }
+  } else {
+    // memory from an allocator that is not hooked (aligned new)
+    current.live -= n < current.live ? n : current.live;
+  }
+}
+
+void heap_info(Phase *) {}
+
+#else
+
+uint32_t base_free = 0;
+uint32_t min_free = 0;
+
+// free heap is O(1) in umm_malloc, cheap enough for every call
+void update_live(void *, bool add) {
+  uint32_t heap = ESP.getFreeHeap();
+  if (!base_free) {
+    base_free = min_free = heap;
+  }
+  if (add && heap < min_free) {
+    min_free = heap;
+  }
+}
+
+void heap_info(Phase *p) {
+  p->max_block = ESP.getMaxFreeBlockSize();
+  p->fragmentation = ESP.getHeapFragmentation();
+}
+
+#endif
+
+Counters snapshot() {
+  Counters c = current;
+#ifndef S28_NATIVE
+  update_live(nullptr, false);
+  uint32_t heap = ESP.getFreeHeap();
+  c.live = base_free > heap ? base_free - heap : 0;
+  c.peak = base_free - min_free;
+#endif
+  return c;
+}
+
+void print(Print &out, const Phase &p, const Counters &prev) {
+  out.printf("%-12s %7u %6u %6u %7u %6u %6u %6u %3u%%\n", p.name,
+             unsigned(p.ms), unsigned(p.counters.allocs - prev.allocs),
+             unsigned(p.counters.frees - prev.frees),
+             unsigned(p.counters.bytes - prev.bytes),
+             unsigned(p.counters.live), unsigned(p.counters.peak),
+             unsigned(p.max_block), unsigned(p.fragmentation));
+}
+
+} // namespace
+
+Counters counters() { return snapshot(); }
+
+void phase(const char *name) {
+  if (phase_count == MAX_PHASES) {
+    return;
+  }
+  Phase &p = phases[phase_count++];
+  p.name = name;
+  p.ms = millis();
+  p.counters = snapshot();
+  heap_info(&p);
+}
+
+void dump(Print &out) {
+  out.printf("%-12s %7s %6s %6s %7s %6s %6s %6s %4s\n", "phase", "ms",
+             "allocs", "frees", "bytes", "live", "peak", "block", "frag");
+  Counters prev;
+  for (int i = 0; i < phase_count; ++i) {
+    print(out, phases[i], prev);
+    prev = phases[i].counters;
+  }
+  Phase now;
+  now.name = "now";
+  now.ms = millis();
+  now.counters = snapshot();
+  heap_info(&now);
+  print(out, now, prev);
+  if (now.counters.failed) {
+    out.printf("failed allocations: %u\n", unsigned(now.counters.failed));
+  }
+}
+
+void command(const char *) { dump(Serial); }
+
+} // namespace alloc_stats
+} // namespace s28
+
+using s28::alloc_stats::allocated;
+using s28::alloc_stats::update_live;
+
+#ifdef S28_NATIVE
+
+// glibc exports its allocator as __libc_*, so defining malloc and friends
+// here takes over every allocation of the process.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+  void *p = __libc_malloc(size);
+  allocated(p, size);
+  update_live(p, true);
+  return p;
+}
+
+void *calloc(size_t n, size_t size) {
+  void *p = __libc_calloc(n, size);
+  allocated(p, n * size);
+  update_live(p, true);
+  return p;
+}
+
+void *realloc(void *ptr, size_t size) {
+  update_live(ptr, false);
+  void *p = __libc_realloc(ptr, size);
+  if (ptr && !size) {
+    // freed, p is NULL
+    s28::alloc_stats::current.frees++;
+    return p;
+  }
+  if (ptr && p && p != ptr) {
+    s28::alloc_stats::current.frees++; // moved
+  }
+  allocated(p, size);
+  update_live(p ? p : ptr, true);
+  return p;
+}
+
+void free(void *ptr) {
+  if (ptr) {
+    s28::alloc_stats::current.frees++;
+    update_live(ptr, false);
+  }
+  __libc_free(ptr);
+}
+} // extern "C"
+
+#else
+
+// Linked with -Wl,--wrap=malloc,... (platformio.ini). newlib's reentrant
+// entry points (strdup, printf) are wrapped as well.
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+  void *p = __real_malloc(size);
+  allocated(p, size);
+  update_live(p, true);
+  return p;
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  void *p = __real_calloc(n, size);
+  allocated(p, n * size);
+  update_live(p, true);
+  return p;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  void *p = __real_realloc(ptr, size);
+  if (ptr && (!size || (p && p != ptr))) {
+    // freed (size 0) or moved
+    s28::alloc_stats::current.frees++;
+  }
+  if (ptr && !size) {
+    return p;
+  }
+  allocated(p, size);
+  update_live(p, true);
+  return p;
+}
+
+void __wrap_free(void *ptr) {
+  if (ptr) {
+    s28::alloc_stats::current.frees++;
+  }
+  __real_free(ptr);
+}
+
+void *__wrap__malloc_r(struct _reent *, size_t size) {
+  return __wrap_malloc(size);
+}
+
+void *__wrap__calloc_r(struct _reent *, size_t n, size_t size) {
+  return __wrap_calloc(n, size);
+}
+
+void *__wrap__realloc_r(struct _reent *, void *ptr, size_t size) {
+  return __wrap_realloc(ptr, size);
+}
+
+void __wrap__free_r(struct _reent *, void *ptr) { __wrap_free(ptr); }
+} // extern "C"
+
+// The core's operator new takes umm_malloc directly (abi.cpp), the wrapped
+// malloc never sees it. Replace the operators so C++ allocations count too.
+namespace {
+void *new_block(size_t size) {
+  void *p = __wrap_malloc(size ? size : 1);
+  if (!p) {
+    abort(); // the core's operator new does not return NULL either
+  }
+  return p;
+}
+} // namespace
+
+void *operator new(size_t size) { return new_block(size); }
+void *operator new[](size_t size) { return new_block(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return __wrap_malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return __wrap_malloc(size ? size : 1);
+}
+
+void operator delete(void *ptr) noexcept { __wrap_free(ptr); }
+void operator delete[](void *ptr) noexcept { __wrap_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { __wrap_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { __wrap_free(ptr); }
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  __wrap_free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  __wrap_free(ptr);
+}
+
+#endif
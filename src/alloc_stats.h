@@ -0,0 +1,53 @@
+#ifndef s28_alloc_stats_h
+#define s28_alloc_stats_h
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace alloc_stats {
+
+// Heap accounting. malloc, calloc, realloc and free are hooked (String and
+// strdup go through them): -Wl,--wrap on the device, libc interposition on
+// the host. The device also replaces operator new/delete, which the core
+// implements without malloc; on the host libstdc++ calls malloc.
+
+struct Counters {
+  size_t allocs = 0; // malloc, calloc, realloc and operator new calls
+  size_t frees = 0;
+  size_t bytes = 0; // requested bytes
+  size_t failed = 0;
+  // Bytes in use and the highest value so far. On the device this is the
+  // drop of the free heap since the first allocation, so SDK and lwIP
+  // buffers count too.
+  size_t live = 0;
+  size_t peak = 0;
+};
+
+Counters counters();
+
+struct Phase {
+  const char *name = nullptr;
+  uint32_t ms = 0;
+  Counters counters;
+  uint32_t max_block = 0;    // largest free block, 0 on the host
+  uint8_t fragmentation = 0; // percent, 0 on the host
+};
+
+constexpr int MAX_PHASES = 12;
+
+// Records a snapshot at a phase boundary, e.g. "args" once the config is
+// read. `name` must be a static string. Phases past MAX_PHASES are dropped.
+void phase(const char *name);
+
+// The phases with the allocations made within each, then the current state.
+void dump(Print &out);
+
+// console command: "heap"
+void command(const char *args);
+
+} // namespace alloc_stats
+} // namespace s28
+
+#endif
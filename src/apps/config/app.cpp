@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include <ArduinoJson.h>
 #include <ESP8266WebServer.h>
 #include <ESP8266WiFi.h>
 #include <ESP8266WiFiMulti.h>
@@ -14,9 +15,18 @@
 #include "app_iface.h"
 
 #include "args.h"
+#include "log_store.h"
 #include "logging.h"
+#include "page.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "sink.h"
 #include "utils.h"
 
+S28_LOG_MODULE(CONFIG, "config")
+
+S28_PROFILE_SPAN(http_span, "http");
+
 using namespace s28::utils;
 using namespace s28;
 
@@ -24,6 +34,7 @@ namespace {
 
 #include "bye_html.h"
 #include "setup_html.h"
+#include "style_css.h"
 
 const char *ssid = "SonoffS26(8)";
 const char *password = "SonoffFwSux";
@@ -34,64 +45,214 @@ IPAddress subnet(255, 255, 255, 0);
 
 ESP8266WebServer *server = nullptr;
 
-String WidlCharVal(char c, StartupArgs &startup_args);
-String SendHTML(StartupArgs &startup_args);
+// pre-gzipped PROGMEM file, see tools/gen_assets.py
+struct StaticAsset {
+  const char *mime;
+  const unsigned char *data;
+  size_t len;
+  const char *etag;
+};
+
+const StaticAsset bye_html = {"text/html", assets_bye_html_gz,
+                              assets_bye_html_gz_len, assets_bye_html_gz_etag};
+const StaticAsset style_css = {"text/css", assets_style_css_gz,
+                               assets_style_css_gz_len,
+                               assets_style_css_gz_etag};
+
+void send_asset(const StaticAsset &asset) {
+  server->sendHeader("ETag", asset.etag);
+  server->sendHeader("Cache-Control", "no-cache");
+  if (server->header("If-None-Match") == asset.etag) {
+    server->send(304);
+    return;
+  }
+  server->sendHeader("Content-Encoding", "gzip");
+  server->send_P(200, asset.mime, (PGM_P)asset.data, asset.len);
+}
+
+// body of a chunked response: small prints are collected and go out as
+// one chunk
+struct ResponsePrint : public ChunkPrint {
+  using ChunkPrint::ChunkPrint;
+
+protected:
+  void send(const char *data, size_t n) override {
+    server->sendContent(data, n);
+  }
+};
 
 struct NetworkInfo {
-  String ssid;
+  FixedString<32> ssid;
   bool open;
 };
 
 struct ServerArgsProxy : public IArgsMap {
   ServerArgsProxy(ESP8266WebServer *server) : server(server) {}
-  String get(const char *name) override { return server->arg(name); }
+  // the server keeps its arguments as Strings, so one copy is unavoidable
+  const char *get(const char *name) override {
+    if (!server->hasArg(name)) {
+      return nullptr;
+    }
+    val = server->arg(name);
+    return val.c_str();
+  }
   ESP8266WebServer *server;
+  String val;
+};
+
+// The fields of a PATCH body. A secret sent back as REDACTED (as GET shows
+// it) stays unchanged.
+struct JsonArgsProxy : public IArgsMap {
+  JsonArgsProxy(JsonObject obj) : obj(obj) {}
+  const char *get(const char *name) override {
+    const char *val = obj[name];
+    if (val && strcmp(val, REDACTED) == 0) {
+      return nullptr;
+    }
+    return val;
+  }
+  JsonObject obj;
 };
 
-struct AppConfig : public s28::App {
+void send_json_error(int code, const char *error, const char *field) {
+  StaticJsonDocument<128> doc;
+  doc["error"] = error;
+  if (field) {
+    doc["field"] = field;
+  }
+  char buf[160];
+  BoundedPrint out(buf, sizeof(buf));
+  serializeJson(doc, out);
+  if (out.overflow()) {
+    // a very long unknown key, the error alone fits
+    doc.remove("field");
+    BoundedPrint retry(buf, sizeof(buf));
+    serializeJson(doc, retry);
+  }
+  server->send(code, "application/json", buf);
+}
+
+// lets the response go out before the restart
+constexpr uint32_t REBOOT_DELAY = 200;
+
+struct AppConfig : public s28::App, public app_config::PageOutput {
+  // the page size must not depend on what the scan finds
+  static constexpr size_t MAX_NETWORKS = 16;
+
   AppConfig(StartupArgs &startup_args) : startup_args(startup_args) {}
 
   std::vector<NetworkInfo> networks;
+  app_config::Page setup_page;
 
-  String networks_html() {
-    String res;
-    for (auto net : networks) {
-      String tmp;
+  ChunkPrint *response = nullptr; // while the setup page renders
 
-      tmp = String("<a href=\"javascript:setSsid('") +
-            escape_html(net.ssid.c_str()) + "')\">" +
-            escape_html(net.ssid.c_str()) + "</a>";
+  uint32_t reboot() {
+    log_store::flush();
+    fs_unmount();
+    ESP.restart();
+    return scheduler::Task::DONE;
+  }
+  scheduler::FnTask reboot_task{"reboot", [this] { return reboot(); }};
 
-      res += String("<p>") + tmp + String("</p>");
+  // chunked, straight from the args table into the socket
+  void send_config_json() {
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "application/json", "");
+    char buf[256];
+    ResponsePrint out(buf, sizeof(buf));
+    print_startup_args_json(out, &startup_args);
+    out.flush();
+    server->sendContent("");
+  }
+
+  // Partial update: only the fields in the body change, so a PATCH with
+  // just a new token keeps the stored fingerprint. A new collector without
+  // a fingerprint clears it, the device probes the new server then. All or
+  // nothing, the config is written only when every field is valid.
+  void patch_config() {
+    StaticJsonDocument<768> doc;
+    String body = server->arg("plain");
+    if (deserializeJson(doc, body) != DeserializationError::Ok ||
+        !doc.is<JsonObject>()) {
+      send_json_error(400, "invalid json object", nullptr);
+      return;
     }
-    return res;
+    JsonObject obj = doc.as<JsonObject>();
+    for (JsonPair kv : obj) {
+      if (!is_startup_arg(kv.key().c_str())) {
+        send_json_error(400, "unknown field", kv.key().c_str());
+        return;
+      }
+      if (!kv.value().is<const char *>()) {
+        send_json_error(400, "not a string", kv.key().c_str());
+        return;
+      }
+    }
+    StartupArgs args = startup_args;
+    JsonArgsProxy proxy(obj);
+    if (!patch_startup_args(proxy, &args)) {
+      send_json_error(400, "value too long", nullptr);
+      return;
+    }
+    if (args.collector != startup_args.collector.c_str() &&
+        !obj.containsKey("fingerprint")) {
+      // the pinned one belongs to the old server
+      args.fingerprint = "";
+    }
+    if (!write_startup_args(&args)) {
+      send_json_error(500, "writing the config failed", nullptr);
+      return;
+    }
+    startup_args = args;
+    LOGI("config updated over the api");
+    send_config_json();
   }
 
-  String WidlCharVal(char c, StartupArgs &startup_args) {
-    switch (c) {
-    case 'F': {
-      String s;
-      gen_html_form_content(s, &startup_args);
-      return s;
+  void print_networks_html(Print &out) {
+    for (auto &net : networks) {
+      out.print("<p><a href=\"javascript:setSsid('");
+      escape_html(out, net.ssid.c_str());
+      out.print("')\">");
+      escape_html(out, net.ssid.c_str());
+      out.print("</a></p>");
     }
+  }
+
+  void literal(const unsigned char *data, size_t len) override {
+    response->flush();
+    server->sendContent_P((PGM_P)data, len);
+  }
+
+  void var(char c) override {
+    switch (c) {
+    case 'F':
+      gen_html_form_content(*response, &startup_args);
+      break;
     case 'n':
-      return networks_html();
+      print_networks_html(*response);
+      break;
     }
-    return String();
   }
 
   bool setup() override {
     server = new ESP8266WebServer(80);
+    if (!setup_page.parse(assets_setup_html, assets_setup_html_len)) {
+      LOGE("setup page has too many placeholders");
+      return false;
+    }
     pinMode(LED_BUILTIN, OUTPUT);
     digitalWrite(LED_BUILTIN, LOW);
 
     WiFi.scanNetworksAsync([this](int networksFound) {
-      Serial.printf("%d network(s) found\n", networksFound);
+      LOGI("%d network(s) found", networksFound);
       networks.clear();
       for (int i = 0; i < networksFound; i++) {
-        Serial.printf("%d: %s, Ch:%d (%ddBm) %s\n", i + 1, WiFi.SSID(i).c_str(),
-                      WiFi.channel(i), WiFi.RSSI(i),
-                      WiFi.encryptionType(i) == ENC_TYPE_NONE ? "open" : "");
+        if (networks.size() == MAX_NETWORKS) {
+          break;
+        }
+        LOGD("%d: %s, Ch:%d (%ddBm) %s", i + 1, WiFi.SSID(i).c_str(),
+             WiFi.channel(i), WiFi.RSSI(i),
+             WiFi.encryptionType(i) == ENC_TYPE_NONE ? "open" : "");
         NetworkInfo info;
         info.open = (WiFi.encryptionType(i) == ENC_TYPE_NONE);
         info.ssid = WiFi.SSID(i).c_str();
@@ -104,24 +265,39 @@ struct AppConfig : public s28::App {
     WiFi.setOutputPower(0);
 
     server->on("/", HTTP_GET, [this]() {
-      String ptr;
-      for (size_t i = 0; i < __assets_setup_html_len; ++i) {
-        char c = __assets_setup_html[i];
-        if (i == __assets_setup_html_len - 1) {
-          ptr += char(c);
-          continue;
-        }
+      // chunked transfer, literal parts are streamed directly from flash
+      server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+      server->send(200, "text/html", "");
+      char buf[256];
+      ResponsePrint out(buf, sizeof(buf));
+      response = &out;
+      setup_page.render(*this);
+      out.flush();
+      response = nullptr;
+      server->sendContent("");
+    });
 
-        if (c == '$') {
-          ptr += WidlCharVal(__assets_setup_html[++i], startup_args);
-          continue;
+    server->on("/style.css", HTTP_GET, []() { send_asset(style_css); });
+    server->on("/reset", HTTP_POST, []() {
+      log_store::flush();
+      fs_unmount();
+      ESP.reset();
+    });
+    server->on("/logs", HTTP_GET, []() {
+      // raw segments, oldest first; decode with tools/log_store.py
+      utils::LittleFSOpener opener;
+      server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+      server->send(200, "application/octet-stream", "");
+      char buf[256];
+      for (size_t i = 0; i < log_store::SEGMENTS; ++i) {
+        File f = LittleFS.open(log_store::segment_name(i), "r");
+        size_t n;
+        while (f && (n = f.read((uint8_t *)buf, sizeof(buf))) > 0) {
+          server->sendContent(buf, n);
         }
-        ptr += char(c);
       }
-      server->send(200, "text/html", ptr);
+      server->sendContent("");
     });
-
-    server->on("/reset", HTTP_POST, []() { ESP.reset(); });
     server->on("/log", HTTP_GET, []() {
       utils::LittleFSOpener opener;
       File f = LittleFS.open("/log", "r");
@@ -130,37 +306,76 @@ struct AppConfig : public s28::App {
         return;
       }
 
-      char *data = new char[f.size()];
-      if (!data) {
-        server->send(400, "text/plain", "the log record is too large!");
-        return;
+      size_t size = f.size();
+      size_t start = 0;
+      size_t end = size;
+      int code = 200;
+      server->sendHeader("Accept-Ranges", "bytes");
+      if (server->hasHeader("Range")) {
+        switch (parse_http_range(server->header("Range").c_str(), size,
+                                 &start, &end)) {
+        case HttpRange::IGNORE:
+          break;
+        case HttpRange::OK:
+          code = 206;
+          server->sendHeader("Content-Range",
+                             String("bytes ") + start + "-" + (end - 1) +
+                                 "/" + size);
+          break;
+        case HttpRange::UNSATISFIABLE:
+          server->sendHeader("Content-Range", String("bytes */") + size);
+          server->send(416, "text/plain", "");
+          return;
+        }
       }
 
-      f.read((uint8_t *)data, f.size());
-      server->send(200, "text/plain", data, f.size());
+      // constant memory, the file goes to the socket in small chunks
+      f.seek(start);
+      server->setContentLength(end - start);
+      server->send(code, "text/plain", "");
+      uint8_t buf[256];
+      for (size_t left = end - start; left;) {
+        size_t n = f.read(buf, std::min(left, sizeof(buf)));
+        if (n == 0 || server->client().write(buf, n) != n) {
+          break;
+        }
+        left -= n;
+      }
     });
     server->on("/", HTTP_POST, []() {
       StartupArgs args;
       ServerArgsProxy proxy(server);
-      update_startup_args(proxy, &args);
+      if (!update_startup_args(proxy, &args)) {
+        server->send(400, "text/html", "value too long");
+        return;
+      }
       args.flags = "0";
 
       if (write_startup_args(&args)) {
-        String s;
-        s.concat((const char *)___assets_bye_html, ___assets_bye_html_len);
-        server->send(200, "text/html", s);
+        send_asset(bye_html);
       } else {
         server->send(400, "text/html", "error");
       }
     });
+    server->on("/api/config", HTTP_GET, [this]() { send_config_json(); });
+    server->on("/api/config", HTTP_PATCH, [this]() { patch_config(); });
+    server->on("/api/reboot", HTTP_POST, [this]() {
+      server->send(202, "application/json", "{\"rebooting\":true}");
+      if (!scheduler::active(&reboot_task)) {
+        scheduler::add(&reboot_task, REBOOT_DELAY);
+      }
+    });
     server->onNotFound([]() { server->send(404, "text/plain", "Not found"); });
+    const char *headers[] = {"If-None-Match", "Range"};
+    server->collectHeaders(headers, sizeof(headers) / sizeof(headers[0]));
     server->begin();
-    Serial.println("HTTP server started");
+    LOGI("HTTP server started");
     return true;
   }
 
   void loop() override { 
    // digitalWrite(s28::gpio_13_led, LOW);
+    S28_PROFILE_SCOPE(http_span);
     server->handleClient();
   }
   StartupArgs &startup_args;
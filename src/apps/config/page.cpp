@@ -0,0 +1,51 @@
+#include "page.h"
+
+namespace s28 {
+namespace app_config {
+
+bool Page::parse(const unsigned char *page, size_t len) {
+  data = page;
+  count = 0;
+
+  size_t start = 0;
+  auto add = [this](size_t offset, size_t len, char var) {
+    if (count == MAX_SEGMENTS) {
+      return false;
+    }
+    segments[count++] = Segment{uint16_t(offset), uint16_t(len), var};
+    return true;
+  };
+
+  // the last byte is never a placeholder
+  for (size_t i = 0; i + 1 < len; ++i) {
+    if (pgm_read_byte(page + i) != '$') {
+      continue;
+    }
+    if (i > start && !add(start, i - start, 0)) {
+      return false;
+    }
+    if (!add(i, 0, pgm_read_byte(page + i + 1))) {
+      return false;
+    }
+    ++i;
+    start = i + 1;
+  }
+  if (len > start) {
+    return add(start, len - start, 0);
+  }
+  return true;
+}
+
+void Page::render(PageOutput &out) const {
+  for (size_t i = 0; i < count; ++i) {
+    const Segment &s = segments[i];
+    if (s.len) {
+      out.literal(data + s.offset, s.len);
+    } else {
+      out.var(s.var);
+    }
+  }
+}
+
+} // namespace app_config
+} // namespace s28
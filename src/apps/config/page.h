@@ -0,0 +1,37 @@
+#ifndef s28_apps_config_page_h
+#define s28_apps_config_page_h
+
+#include <Arduino.h>
+
+namespace s28 {
+namespace app_config {
+
+// Receives a rendered page piece by piece. Literal runs point straight into
+// the (PROGMEM) template, so nothing is copied to heap.
+struct PageOutput {
+  virtual void literal(const unsigned char *data, size_t len) = 0;
+  virtual void var(char c) = 0; // $<c> placeholder
+};
+
+// html template split into literal runs and $<c> placeholders; parsed once
+struct Page {
+  static constexpr size_t MAX_SEGMENTS = 16;
+
+  struct Segment {
+    uint16_t offset;
+    uint16_t len; // 0 for a placeholder
+    char var;
+  };
+
+  bool parse(const unsigned char *data, size_t len);
+  void render(PageOutput &out) const;
+
+  const unsigned char *data = nullptr;
+  Segment segments[MAX_SEGMENTS];
+  size_t count = 0;
+};
+
+} // namespace app_config
+} // namespace s28
+
+#endif
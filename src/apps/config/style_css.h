@@ -0,0 +1,34 @@
+// generated by tools/gen_assets.py from assets/style.css, do not edit
+// 794 bytes, gzipped to 335 bytes
+static const unsigned char assets_style_css_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x52,
+  0x5b, 0x6e, 0x83, 0x30, 0x10, 0xfc, 0xe7, 0x14, 0x96, 0xfa, 0x5b, 0x57,
+  0x25, 0x24, 0x12, 0x71, 0x2e, 0x90, 0x6b, 0xf8, 0x05, 0x58, 0x31, 0x5e,
+  0x64, 0x96, 0x26, 0x69, 0xd5, 0xbb, 0xd7, 0xc5, 0xc6, 0x25, 0x69, 0xd4,
+  0xfa, 0x07, 0x69, 0xc7, 0x3b, 0x33, 0x1e, 0xa6, 0xc3, 0xde, 0x92, 0x8f,
+  0x82, 0x84, 0xd3, 0x80, 0x43, 0xda, 0xf0, 0xde, 0xd8, 0x2b, 0x23, 0x47,
+  0x6d, 0xdf, 0x34, 0x1a, 0xc9, 0x0f, 0x33, 0xa6, 0xcc, 0x38, 0x58, 0x1e,
+  0xe6, 0xc6, 0x59, 0xe3, 0x34, 0x15, 0x16, 0xe4, 0x29, 0x42, 0x3d, 0xf7,
+  0xad, 0x71, 0x8c, 0xbc, 0x0e, 0x17, 0xc2, 0x27, 0x84, 0x38, 0x45, 0x7d,
+  0x41, 0xca, 0xad, 0x69, 0x03, 0x22, 0xb5, 0x43, 0xed, 0x0f, 0xc5, 0x67,
+  0x51, 0x08, 0x50, 0xd7, 0x24, 0x17, 0xf7, 0x28, 0xc2, 0xc0, 0xc8, 0x2e,
+  0x2c, 0xcf, 0x78, 0x57, 0x26, 0x54, 0x82, 0x05, 0xcf, 0xc8, 0xd3, 0x76,
+  0x3e, 0xb7, 0x4a, 0xbb, 0x45, 0x8a, 0x54, 0x79, 0xaf, 0xfa, 0x77, 0x8f,
+  0x0a, 0x40, 0x84, 0x7e, 0x25, 0xf6, 0x22, 0xa6, 0x30, 0x71, 0xcf, 0x24,
+  0x7e, 0x13, 0x43, 0x7e, 0xea, 0xea, 0x8d, 0x82, 0xcb, 0x53, 0xeb, 0x61,
+  0x72, 0x8a, 0x2e, 0x02, 0x25, 0x17, 0x72, 0x2f, 0x13, 0x0c, 0x5e, 0xe9,
+  0x30, 0x74, 0xe0, 0xf4, 0x61, 0x6d, 0xe3, 0xdc, 0x19, 0x4c, 0x93, 0x81,
+  0x2b, 0x65, 0x5c, 0xcb, 0x48, 0x59, 0x05, 0xf7, 0xd1, 0x78, 0x0e, 0x4a,
+  0x69, 0x09, 0x9e, 0xa3, 0x01, 0xb7, 0x26, 0x99, 0x7f, 0xc8, 0x68, 0xde,
+  0x35, 0x23, 0x9b, 0xdd, 0x72, 0xff, 0x3e, 0x6e, 0x52, 0x65, 0x48, 0x4e,
+  0x7e, 0xfc, 0x56, 0x1d, 0xc0, 0xc4, 0xc0, 0x7f, 0xbc, 0x51, 0xcf, 0x95,
+  0x99, 0x46, 0x46, 0xb6, 0xb7, 0x3c, 0x31, 0xfe, 0xc8, 0x1e, 0x12, 0x19,
+  0xd6, 0x55, 0x88, 0xca, 0x65, 0xde, 0x58, 0x5e, 0x5e, 0xd7, 0xf5, 0xc3,
+  0x5c, 0xcb, 0x9c, 0xab, 0xe5, 0x42, 0xdb, 0xfb, 0x38, 0x7f, 0x37, 0xe7,
+  0x6c, 0x14, 0x76, 0x6c, 0x9f, 0xfd, 0xa7, 0x88, 0xa2, 0xa7, 0x7a, 0x21,
+  0x73, 0x1a, 0x1b, 0xf0, 0x7d, 0xa2, 0x8b, 0x3b, 0xa4, 0xda, 0xdc, 0x06,
+  0x98, 0x9a, 0x66, 0x75, 0x83, 0x7f, 0x16, 0x76, 0x4d, 0x98, 0xbb, 0xf6,
+  0xb8, 0xab, 0x5f, 0x51, 0x3b, 0x34, 0x38, 0x1a, 0x03, 0x00, 0x00
+};
+static const size_t assets_style_css_gz_len = 335;
+static const char assets_style_css_gz_etag[] = "\"39f71f47bcba9366\"";
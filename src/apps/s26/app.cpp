@@ -17,15 +17,30 @@
 #include <string>
 #include <vector>
 
+#include "alloc_stats.h"
 #include "app.h"
 #include "apps/config/app.h"
+#include "console.h"
+#include "log_store.h"
 #include "logging.h"
+#include "metrics.h"
+#include "profiler.h"
+#include "relay_latency.h"
+#include "scheduler.h"
+#include "tls_profile.h"
+#include "tls_session.h"
 #include "utils.h"
+#include "wifi_cache.h"
 
 using namespace s28;
 using namespace s28::utils;
 #include "apps/s26/app.h"
 
+S28_LOG_MODULE(S26, "s26")
+
+S28_PROFILE_SPAN(blynk_span, "blynk.run");
+S28_PROFILE_SPAN(setup_ctl_span, "setup_ctl");
+
 
 namespace {
 
@@ -99,6 +114,7 @@ private:
     write_startup_args(&startup_args);
     digitalWrite(s28::gpio_13_led, LOW);
     flush_log_history();
+    log_store::flush();
   }
 
   void leave() {
@@ -117,92 +133,501 @@ SetupCtl *SetupCtl::instance = nullptr;
 
 bool check_args(const StartupArgs &args) {
   if (!args.ok) {
-    log("invalid config mini-file. Please configure first!");
+    LOGW("invalid config mini-file. Please configure first!");
     return false;
   }
   if (args.ssid.isEmpty()) {
-    log("SSID not configured");
+    LOGW("SSID not configured");
     return false;
   }
   if (args.token.length() < 5) {
-    log("Blynk token not configured");
+    LOGW("Blynk token not configured");
     return false;
   }
   return true;
 }
 
+// a cached access point that does not answer within this time is dropped
+constexpr uint32_t FAST_CONNECT_TIMEOUT = 4000;
+constexpr uint32_t WIFI_POLL_INTERVAL = 10;
+// after a cached connect, a DHCP lease that does not come within this
+// time invalidates the cached one
+constexpr uint32_t DHCP_TIMEOUT = 15000;
+constexpr uint32_t DHCP_POLL_INTERVAL = 100;
+constexpr uint32_t PROBE_POLL_INTERVAL = 5;
+constexpr uint32_t PROBE_RETRY_INTERVAL = 500;
+constexpr uint32_t LATENCY_PUBLISH_INTERVAL = 60000;
+
+// updated by the Blynk handlers below
+uint32_t blynk_connects = 0;
+uint32_t relay_toggles = 0;
+int relay_state = LOW;
+
+bool config_static_ip(const StartupArgs &args) {
+  if (args.ip.isEmpty()) {
+    return false;
+  }
+  IPAddress ip, gateway, dns;
+  IPAddress netmask(255, 255, 255, 0);
+  if (!ip.fromString(args.ip.c_str()) ||
+      !gateway.fromString(args.gateway.c_str()) ||
+      (!args.netmask.isEmpty() && !netmask.fromString(args.netmask.c_str()))) {
+    LOGW("invalid static ip config, using DHCP");
+    return false;
+  }
+  if (!dns.fromString(args.dns.c_str())) {
+    dns = gateway;
+  }
+  WiFi.config(ip, gateway, netmask, dns);
+  return true;
+}
+
+// GET /metrics on port 80, one client at a time, driven by a scheduler
+// task so it never runs inside Blynk.run(). No step waits: the request is
+// read as it arrives and the response goes out as far as the socket buffer
+// takes it, one metric family at a time from a snapshot of the values.
+struct MetricsServer {
+  static constexpr uint16_t PORT = 80;
+  static constexpr uint32_t POLL_INTERVAL = 20;
+  static constexpr uint32_t CLIENT_TIMEOUT = 2000;
+
+  explicit MetricsServer(std::function<void(metrics::Sample *)> collect)
+      : collect(collect) {}
+
+  void begin();
+  uint32_t step();
+
+private:
+  void respond();
+  void close();
+
+  enum State { IDLE, REQUEST, RESPONSE, DRAIN };
+  State state = IDLE;
+  bool started = false;
+  std::function<void(metrics::Sample *)> collect;
+  WiFiServer server{PORT};
+  WiFiClient client;
+  uint32_t since = 0;
+  size_t sndbuf = 0; // free send buffer of an idle connection
+  char line[24];     // start of the request line
+  size_t line_len = 0;
+  uint32_t tail = 0; // last bytes read, to find the blank line
+  metrics::Sample sample;
+  size_t family = 0; // next one to render
+  char chunk[metrics::MAX_FAMILY_LEN];
+  size_t chunk_len = 0;
+  size_t sent = 0;
+};
+
+void MetricsServer::begin() {
+  if (!started) {
+    server.begin();
+    started = true;
+  }
+}
+
+uint32_t MetricsServer::step() {
+  if (state == IDLE) {
+    client = server.available();
+    if (!client) {
+      return POLL_INTERVAL;
+    }
+    client.setNoDelay(true);
+    sndbuf = client.availableForWrite();
+    since = millis();
+    line_len = 0;
+    tail = 0;
+    state = REQUEST;
+  }
+  if (millis() - since > CLIENT_TIMEOUT || !client.connected()) {
+    close();
+    return POLL_INTERVAL;
+  }
+
+  switch (state) {
+  case REQUEST:
+    while (client.available() > 0) {
+      int c = client.read();
+      if (line_len < sizeof(line) - 1) {
+        line[line_len++] = c;
+      }
+      tail = (tail << 8) | uint8_t(c);
+      if (tail == 0x0d0a0d0a || (tail & 0xffff) == 0x0a0a) {
+        line[line_len] = 0;
+        respond();
+        break;
+      }
+    }
+    break;
+  case RESPONSE: {
+    size_t n = std::min(chunk_len - sent, client.availableForWrite());
+    if (n) {
+      sent += client.write((const uint8_t *)chunk + sent, n);
+    }
+    if (sent < chunk_len) {
+      break;
+    }
+    if (family == metrics::FAMILY_COUNT) {
+      state = DRAIN;
+      break;
+    }
+    // respond() checked that every family fits
+    chunk_len = metrics::render_family(sample, family++, chunk, sizeof(chunk));
+    sent = 0;
+    break;
+  }
+  case DRAIN:
+    // stop() would wait for the peer's ACK, so wait here instead
+    if (client.availableForWrite() >= sndbuf) {
+      close();
+    }
+    break;
+  case IDLE:
+    break;
+  }
+  return state == IDLE ? POLL_INTERVAL : 1;
+}
+
+void MetricsServer::respond() {
+  static const char ok[] = "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/plain; version=0.0.4\r\n"
+                           "Connection: close\r\n\r\n";
+  static const char not_found[] = "HTTP/1.1 404 Not Found\r\n"
+                                  "Connection: close\r\n\r\n";
+  static const char error[] = "HTTP/1.1 500 Internal Server Error\r\n"
+                              "Connection: close\r\n\r\n";
+  static_assert(sizeof(ok) <= sizeof(chunk), "headers fit into a chunk");
+  const char *head = not_found;
+  size_t head_len = sizeof(not_found) - 1;
+  family = metrics::FAMILY_COUNT; // no body
+  if (strncmp(line, "GET /metrics", 12) == 0 &&
+      (line[12] == ' ' || line[12] == '?')) {
+    collect(&sample);
+    head = ok;
+    head_len = sizeof(ok) - 1;
+    family = 0;
+    // the status goes out first, so make sure the body can follow
+    for (size_t i = 0; i < metrics::FAMILY_COUNT; ++i) {
+      if (!metrics::render_family(sample, i, chunk, sizeof(chunk))) {
+        LOGE("metric family %u does not fit", unsigned(i));
+        head = error;
+        head_len = sizeof(error) - 1;
+        family = metrics::FAMILY_COUNT;
+        break;
+      }
+    }
+  }
+  memcpy(chunk, head, head_len);
+  chunk_len = head_len;
+  sent = 0;
+  state = RESPONSE;
+}
+
+void MetricsServer::close() {
+  client.stop();
+  state = IDLE;
+}
+
+// Connecting runs as scheduler tasks: wifi, then the fingerprint probe
+// when needed, then Blynk. The main loop keeps running meanwhile.
 struct SonoffS26 : s28::App {
   SonoffS26(StartupArgs &startup_args) : startup_args(startup_args) {}
   StartupArgs &startup_args;
   int setup_sensors(const StartupArgs &args);
+  bool setup_requested() const;
+  void start_wifi();
+  uint32_t wifi_step();
+  void wifi_connected();
+  void save_lease();
+  uint32_t dhcp_step();
+  uint32_t probe_step();
   void connect_blynk();
   bool setup() override;
   void loop() override;
   void timer_loop();
+
+  enum WifiState { WIFI_CACHED, WIFI_SCAN, WIFI_DHCP };
+  WifiState wifi_state = WIFI_SCAN;
+  bool static_ip = false;
+  uint32_t wifi_start = 0;
+  uint32_t wifi_last_log = 0;
+  uint32_t dhcp_since = 0;
+  volatile bool got_ip = false; // set from the SDK event
+  WiFiEventHandler got_ip_handler;
+  scheduler::FnTask wifi_task{"wifi", [this] { return wifi_step(); }};
+
+  s28::Fingerprint fingerprint;
+  std::unique_ptr<s28::Probe> probe;
+  scheduler::FnTask probe_task{"probe", [this] { return probe_step(); }};
+
+  bool blynk_configured = false;
+
+  uint32_t latency_published = 0; // sample count last sent to V2
+  uint32_t publish_latency();
+  scheduler::FnTask latency_task{"latency",
+                                 [this] { return publish_latency(); }};
+
+  metrics::LoopMeter loop_meter;
+  void collect_metrics(metrics::Sample *s);
+  MetricsServer metrics_server{
+      [this](metrics::Sample *s) { collect_metrics(s); }};
+  scheduler::FnTask metrics_task{"metrics",
+                                 [this] { return metrics_server.step(); }};
 };
 
+void SonoffS26::collect_metrics(metrics::Sample *s) {
+  auto handshakes = [](const tls_session::HandshakeStats &h) {
+    return metrics::Handshakes{h.count, h.total_ms, h.max_ms, h.last_ms};
+  };
+  tls_session::Stats tls = tls_session::stats();
+  s->uptime_s = uint32_t(micros64() / 1000000);
+  s->free_heap = ESP.getFreeHeap();
+  s->max_free_block = ESP.getMaxFreeBlockSize();
+  s->fragmentation = ESP.getHeapFragmentation();
+  s->loops = loop_meter.loops;
+  s->loop_max_us = loop_meter.max_us();
+  s->rssi = WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0;
+  s->blynk_connects = blynk_connects;
+  s->relay_toggles = relay_toggles;
+  s->tls_full = handshakes(tls.full);
+  s->tls_resumed = handshakes(tls.resumed);
+}
+
+void latency_command(const char *args) {
+  if (strcmp(args, "reset") == 0) {
+    relay_latency::reset();
+    return;
+  }
+  char buf[64];
+  relay_latency::format(buf, sizeof(buf));
+  relay_latency::Stats s = relay_latency::stats();
+  Serial.printf("%s\nrun->handler last=%uus max=%uus\n"
+                "handler->relay last=%uus max=%uus\n",
+                buf, unsigned(s.run_to_handler.last_us),
+                unsigned(s.run_to_handler.max_us),
+                unsigned(s.handler_to_relay.last_us),
+                unsigned(s.handler_to_relay.max_us));
+}
+
+// The summary goes to V2 only when there are new samples, so an idle relay
+// costs no traffic.
+uint32_t SonoffS26::publish_latency() {
+  uint32_t count = relay_latency::stats().total.count;
+  if (Blynk.connected() && count != latency_published) {
+    char buf[64];
+    relay_latency::format(buf, sizeof(buf));
+    Blynk.virtualWrite(V2, buf);
+    latency_published = count;
+  }
+  return LATENCY_PUBLISH_INTERVAL;
+}
+
 void SonoffS26::connect_blynk() {
+  tls_session::begin(&_blynkWifiClient);
+  size_t suite_count;
+  const uint16_t *suites =
+      tls_profile::suites(tls_profile::DEFAULT, &suite_count);
+  _blynkWifiClient.setCiphers(suites, suite_count);
   if (!startup_args.has_custom_blynk_server()) {
-    log("connecting Blynk in cloud [%s]", startup_args.collector.c_str());
+    LOGI("connecting Blynk in cloud [%s]", startup_args.collector.c_str());
     Blynk.config(startup_args.token.c_str());
   } else {
-    log("connecting custom Blynk server");
+    LOGI("connecting custom Blynk server");
     IPAddress blinkIp;
-    blinkIp.fromString(startup_args.collector);
+    blinkIp.fromString(startup_args.collector.c_str());
     Blynk.config(startup_args.token.c_str(), blinkIp, 9443,
                  startup_args.fingerprint.c_str());
-    log("connecting: %s", blinkIp.toString().c_str());
+    LOGI("connecting: %s", blinkIp.toString().c_str());
   }
-  log("key: [%s]", startup_args.token.c_str());
-  log("connecting blynk...");
-  Blynk.connect();
+  LOGD("key: [%s]", startup_args.token.c_str());
+  // the connect itself happens in Blynk.run(), see loop()
+  blynk_configured = true;
+  if (!scheduler::active(&latency_task)) {
+    scheduler::add(&latency_task, LATENCY_PUBLISH_INTERVAL);
+  }
+  scheduler::dump();
 }
 
-bool SonoffS26::setup() {
-  if (!check_args(startup_args)) { // vary basic args sanity check
-    return false;
+bool SonoffS26::setup_requested() const {
+  return SetupCtl::will_enter() || startup_args.is_entering_setup();
+}
+
+// Joins the last access point with the last lease when they are cached (no
+// scan, no DHCP round trip before the connect), wifi_step() falls back to a
+// regular connect. Once connected, DHCP takes the address over again.
+void SonoffS26::start_wifi() {
+  const char *ssid = startup_args.ssid.c_str();
+  const char *password = startup_args.password.c_str();
+
+  // the SDK would store its own copy of the config on every begin()
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+  static_ip = config_static_ip(startup_args);
+
+  wifi_start = millis();
+  wifi_last_log = wifi_start;
+  wifi_cache::Lease lease;
+  if (wifi_cache::load(ssid, &lease)) {
+    if (!static_ip && lease.ip) {
+      WiFi.config(IPAddress(lease.ip), IPAddress(lease.gateway),
+                  IPAddress(lease.netmask), IPAddress(lease.dns));
+    }
+    WiFi.begin(ssid, password, lease.channel, lease.bssid);
+    wifi_state = WIFI_CACHED;
+  } else {
+    WiFi.begin(ssid, password);
+    wifi_state = WIFI_SCAN;
   }
+  scheduler::add(&wifi_task, WIFI_POLL_INTERVAL);
+}
 
-  int status = WL_DISCONNECTED;
-  WiFi.begin(startup_args.ssid.c_str(), startup_args.password.c_str());
-  while ((status = WiFi.status()) != WL_CONNECTED) {
-    if (SetupCtl::will_enter())
-      return false;
-    log("wifi not connected, retry %d", int(status));
-    delay(1000);
+uint32_t SonoffS26::wifi_step() {
+  if (setup_requested()) {
+    return scheduler::Task::DONE;
   }
 
-  log("WiFi connected, Gateway Ip: %s", WiFi.gatewayIP().toString().c_str());
+  if (wifi_state == WIFI_DHCP) {
+    return dhcp_step();
+  }
+
+  int status = WiFi.status();
+  if (status == WL_CONNECTED) {
+    wifi_connected();
+    return wifi_state == WIFI_DHCP ? DHCP_POLL_INTERVAL
+                                   : scheduler::Task::DONE;
+  }
+
+  uint32_t now = millis();
+  if (wifi_state == WIFI_CACHED && now - wifi_start > FAST_CONNECT_TIMEOUT) {
+    LOGW("fast reconnect failed, scanning");
+    wifi_cache::forget();
+    WiFi.disconnect();
+    if (!static_ip) {
+      WiFi.config(0u, 0u, 0u); // back to DHCP
+    }
+    WiFi.begin(startup_args.ssid.c_str(), startup_args.password.c_str());
+    wifi_state = WIFI_SCAN;
+  }
+  if (now - wifi_last_log >= 1000) {
+    LOGD("wifi not connected, retry %d", status);
+    wifi_last_log = now;
+  }
+  return WIFI_POLL_INTERVAL;
+}
+
+void SonoffS26::wifi_connected() {
+  LOGI("WiFi connected in %u ms (%s), Gateway Ip: %s",
+       unsigned(millis() - wifi_start),
+       wifi_state == WIFI_CACHED ? "cached" : "scan",
+       WiFi.gatewayIP().toString().c_str());
+
+  save_lease();
+  alloc_stats::phase("wifi");
+
+  if (wifi_state == WIFI_CACHED && !static_ip) {
+    // The cached lease is configured as a static address and would never
+    // be renewed. Start DHCP, the address stays up until it binds.
+    got_ip = false;
+    got_ip_handler = WiFi.onStationModeGotIP(
+        [this](const WiFiEventStationModeGotIP &) { got_ip = true; });
+    WiFi.config(0u, 0u, 0u);
+    wifi_state = WIFI_DHCP;
+    dhcp_since = millis();
+  }
+
+  metrics_server.begin();
+  if (!scheduler::active(&metrics_task)) {
+    scheduler::add(&metrics_task);
+  }
 
   if (startup_args.has_custom_blynk_server()) {
     if (startup_args.fingerprint.length() < 5) {
-      s28::Fingerprint fingerprint;
-      for (;;) {
-        if (s28::probe(startup_args.collector, 9443, &fingerprint) == 0) {
-          log("? Fingerprint: [%s]", fingerprint.to_string().c_str());
-          startup_args.fingerprint = fingerprint.to_string();
-          write_startup_args(&startup_args);
-          break;
-        }
-
-        if (SetupCtl::will_enter()) {
-          return false;
-        }
-
-        log("Fingerprint probe failed!");
-        delay(500);
-      }
-    } else {
-      log("! Fingerprint: [%s]", startup_args.fingerprint.c_str());
+      scheduler::add(&probe_task);
+      return;
     }
+    LOGI("! Fingerprint: [%s]", startup_args.fingerprint.c_str());
   } else {
-    log("will check the cert");
+    LOGD("will check the cert");
   }
   connect_blynk();
+}
+
+void SonoffS26::save_lease() {
+  wifi_cache::Lease now;
+  memcpy(now.bssid, WiFi.BSSID(), sizeof(now.bssid));
+  now.channel = WiFi.channel();
+  now.ip = WiFi.localIP();
+  now.gateway = WiFi.gatewayIP();
+  now.netmask = WiFi.subnetMask();
+  now.dns = WiFi.dnsIP();
+  wifi_cache::save(startup_args.ssid.c_str(), now);
+}
+
+uint32_t SonoffS26::dhcp_step() {
+  if (got_ip) {
+    LOGI("DHCP lease: %s", WiFi.localIP().toString().c_str());
+    save_lease();
+  } else if (millis() - dhcp_since < DHCP_TIMEOUT) {
+    return DHCP_POLL_INTERVAL;
+  } else {
+    LOGW("no DHCP lease, dropping the cached one");
+    wifi_cache::forget();
+  }
+  got_ip_handler = nullptr;
+  return scheduler::Task::DONE;
+}
+
+uint32_t SonoffS26::probe_step() {
+  if (setup_requested()) {
+    probe.reset();
+    return scheduler::Task::DONE;
+  }
+  if (!probe) {
+    probe.reset(
+        new s28::Probe(startup_args.collector.c_str(), 9443, &fingerprint));
+  }
+
+  switch (probe->step()) {
+  case s28::Probe::PENDING:
+    return PROBE_POLL_INTERVAL;
+  case s28::Probe::OK:
+    probe.reset();
+    alloc_stats::phase("probe");
+    LOGI("? Fingerprint: [%s]", fingerprint.to_string().c_str());
+    startup_args.fingerprint = fingerprint.to_string().c_str();
+    write_startup_args(&startup_args);
+    connect_blynk();
+    return scheduler::Task::DONE;
+  case s28::Probe::FAILED:
+    break;
+  }
+  probe.reset();
+  LOGW("Fingerprint probe failed!");
+  return PROBE_RETRY_INTERVAL;
+}
+
+bool SonoffS26::setup() {
+  if (!check_args(startup_args)) { // vary basic args sanity check
+    return false;
+  }
+  console::add("latency", "relay latency, \"latency reset\" clears",
+               latency_command);
+  start_wifi();
   return true;
 }
 
-void SonoffS26::loop() { Blynk.run(); }
+void SonoffS26::loop() {
+  loop_meter.tick(micros());
+  if (blynk_configured) {
+    // connects and reconnects happen inside run(), the TCP connect and TLS
+    // handshake block this loop
+    tls_session::HandshakeWatch watch;
+    relay_latency::run_entered();
+    S28_PROFILE_SCOPE(blynk_span);
+    Blynk.run();
+    relay_latency::run_left();
+  }
+}
 
 void ICACHE_RAM_ATTR handleInterrupt() {
   if (SetupCtl::schedule_enter()) {
@@ -226,12 +651,12 @@ struct SwitchConfigProxyApp : public s28::App {
     }
 
     if (!parent) {
-      log("fatal: app not created");
+      LOGE("fatal: app not created");
       return true;
     }
 
     if (!parent->setup()) {
-      log("parent setup failed");
+      LOGE("parent setup failed");
       delete parent;
       parent = nullptr;
     }
@@ -242,6 +667,7 @@ struct SwitchConfigProxyApp : public s28::App {
     if (parent) {
       parent->loop();
     }
+    S28_PROFILE_SCOPE(setup_ctl_span);
     SetupCtl::call_loop();
   }
 
@@ -267,20 +693,24 @@ s28::App *create(StartupArgs &args) {
 
 // Blynk functions ---
 BLYNK_CONNECTED() {
-  s28::log("blynk sync");
+  if (!blynk_connects) {
+    alloc_stats::phase("blynk");
+  }
+  blynk_connects++;
+  LOGD("blynk sync");
   Blynk.syncVirtual(V1);
 }
 
 BLYNK_WRITE(V1) {
+  relay_latency::handler_entered();
   int pinValue = param.asInt();
-  s28::log("event: %d", pinValue);
-  if (pinValue) {
-    digitalWrite(
-        s28::gpio_12_relay,
-        HIGH); // Turn relay ON.  Power ON the devices connected to Sonoff
-  } else {
-    digitalWrite(
-        s28::gpio_12_relay,
-        LOW); // Turn relay ON.  Power ON the devices connected to Sonoff
+  int state = pinValue ? HIGH : LOW;
+  // Turn relay ON/OFF. Powers the devices connected to the Sonoff
+  digitalWrite(s28::gpio_12_relay, state);
+  relay_latency::relay_written();
+  if (state != relay_state) {
+    relay_state = state;
+    relay_toggles++;
   }
-}
\ No newline at end of file
+  LOGI("event: %d", pinValue);
+}
@@ -6,63 +6,123 @@
 #include <stdarg.h>
 
 #include "logging.h"
+#include "profiler.h"
+#include "rtc_mem.h"
 #include "utils.h"
 
+S28_LOG_MODULE(ARGS, "args")
+
+S28_PROFILE_SPAN(write_span, "args.write");
+
 using namespace s28::utils;
 namespace s28 {
 namespace {
 
-static const char *config_file_name = "/xconfig";
+// Config record, written alternately to two slot files so a reset during
+// a save always leaves the previous record intact:
+//   RecordHeader | (tag, len, bytes)*
+// The CRC covers the header (with crc = 0) and the payload. The newest
+// valid slot wins. JSON (/xconfig) is only used for import/export.
+static const char *legacy_config_file_name = "/xconfig";
+static const char *slot_file_names[2] = {"/cfg.0", "/cfg.1"};
+
+constexpr uint32_t RECORD_MAGIC = 0x43383253; // "S28C"
+constexpr uint16_t RECORD_FORMAT = 1;
+
+struct RecordHeader {
+  uint32_t magic;
+  uint16_t format;
+  uint16_t len; // payload
+  uint32_t seq;
+  uint32_t crc;
+} __attribute__((packed));
+
+// Access to one StartupArgs member from the tables below; the member's
+// capacity is the field's length limit.
+typedef StrRef (*Member)(StartupArgs *args);
+
+template <typename T, T StartupArgs::*M> StrRef member(StartupArgs *args) {
+  return (args->*M).ref();
+}
+
+#define ARGS_MEMBER(m) &member<decltype(StartupArgs::m), &StartupArgs::m>
+
+// Persistent fields. The tag identifies a field in the binary record and
+// must never be reused.
+struct Field {
+  uint8_t tag;
+  const char *id;
+  Member val;
+};
+
+static const Field fields[] = {
+    {1, "flags", ARGS_MEMBER(flags)},
+    {2, "version", ARGS_MEMBER(version)},
+    {3, "ssid", ARGS_MEMBER(ssid)},
+    {4, "password", ARGS_MEMBER(password)},
+    {5, "collector", ARGS_MEMBER(collector)},
+    {6, "token", ARGS_MEMBER(token)},
+    {7, "fingerprint", ARGS_MEMBER(fingerprint)},
+    {8, "ip", ARGS_MEMBER(ip)},
+    {9, "gateway", ARGS_MEMBER(gateway)},
+    {10, "netmask", ARGS_MEMBER(netmask)},
+    {11, "dns", ARGS_MEMBER(dns)},
+};
+
+// slot holding the newest record, -1 if not known yet
+int newest_slot = -1;
+uint32_t newest_seq = 0;
 
 struct ArgsIO {
-  virtual void io(const char *key, String &val) = 0;
+  virtual void io(const char *key, StrRef val) = 0;
   virtual bool check(const char *key) = 0;
 };
 
 struct ArgsGetter : public ArgsIO {
-  ArgsGetter(DynamicJsonDocument &json) : json(json) {}
+  ArgsGetter(JsonDocument &json) : json(json) {}
 
-  void io(const char *key, String &val) {
-    JsonVariant tmp = json[key];
-    if (tmp.isNull() || tmp.isUndefined()) {
-      val = "";
-      return;
+  void io(const char *key, StrRef val) {
+    const char *tmp = json[key] | "";
+    if (!val.assign(tmp)) {
+      LOGW("%s is longer than %d characters", key, int(val.cap));
+      fits = false;
     }
-    val = tmp.as<String>();
   }
 
   bool check(const char *key) {
     if (!json[key].is<String>()) {
-      log("key: [%s] has invalid type", key);
+      LOGW("key: [%s] has invalid type", key);
       return false;
     } else {
-      log("key: [%s] has good type", key);
+      LOGD("key: [%s] has good type", key);
     }
     return true;
   }
 
-  DynamicJsonDocument &json;
+  JsonDocument &json;
+  bool fits = true;
 };
 
 struct ArgsSetter : public ArgsIO {
-  ArgsSetter(DynamicJsonDocument &json) : json(json) {}
+  ArgsSetter(JsonDocument &json) : json(json) {}
 
-  void io(const char *key, String &val) { json[key] = val; }
+  // the document only points to the value
+  void io(const char *key, StrRef val) { json[key] = val.c_str(); }
 
   bool check(const char *key) { return true; }
 
-  DynamicJsonDocument &json;
+  JsonDocument &json;
 };
 
 struct Arg {
   const char *id;
   const char *long_name;
-  String StartupArgs::*val;
-  enum ArgEntryType { TITLE, SECTION, ARG, ARG_ID, END };
+  Member val;
+  enum ArgEntryType { TITLE, SECTION, ARG, ARG_ID, SECRET, END };
   ArgEntryType type;
 
   static const bool is_arg(ArgEntryType at) {
-    if (at == ARG || at == ARG_ID) {
+    if (at == ARG || at == ARG_ID || at == SECRET) {
       return true;
     }
     return false;
@@ -73,92 +133,316 @@ namespace {
 static const Arg arg_list[] = {
     {"WiFi", nullptr, nullptr, Arg::TITLE},
 
-    {"ssid", "SSID", &StartupArgs::ssid, Arg::ARG},
-    {"password", "password", &StartupArgs::password, Arg::ARG},
+    {"ssid", "SSID", ARGS_MEMBER(ssid), Arg::ARG},
+    {"password", "password", ARGS_MEMBER(password), Arg::SECRET},
     //---
     {"Blynk server", nullptr, nullptr, Arg::TITLE},
 
-    {"collector", "server ip", &StartupArgs::collector, Arg::ARG},
-    {"token", "token", &StartupArgs::token, Arg::ARG},
-    {"fingerprint", "fingerprint", &StartupArgs::fingerprint, Arg::ARG},
+    {"collector", "server ip", ARGS_MEMBER(collector), Arg::ARG},
+    {"token", "token", ARGS_MEMBER(token), Arg::SECRET},
+    {"fingerprint", "fingerprint", ARGS_MEMBER(fingerprint), Arg::ARG},
+    //---
+    {"Static IP (empty for DHCP)", nullptr, nullptr, Arg::TITLE},
+
+    {"ip", "ip", ARGS_MEMBER(ip), Arg::ARG},
+    {"gateway", "gateway", ARGS_MEMBER(gateway), Arg::ARG},
+    {"netmask", "netmask", ARGS_MEMBER(netmask), Arg::ARG},
+    {"dns", "dns", ARGS_MEMBER(dns), Arg::ARG},
 
     {nullptr, nullptr, nullptr, Arg::END}};
 } // namespace
 
 void handle_args(ArgsIO &aio, StartupArgs *args) {
-  // explicit arguments
-  aio.io("flags", args->flags);
-  aio.io("version", args->version);
-  // from arg_list
-  for (const Arg &a : arg_list) {
-    if (Arg::is_arg(a.type)) {
-      aio.io(a.id, args->*(a.val));
-    }
+  for (const Field &f : fields) {
+    aio.io(f.id, f.val(args));
   }
 }
 
+uint32_t record_crc(RecordHeader h, const uint8_t *payload) {
+  h.crc = 0;
+  return crc32(payload, h.len, crc32(&h, sizeof(h)));
+}
+
+bool read_slot(int slot, RecordHeader *h, uint8_t *payload) {
+  File f = LittleFS.open(slot_file_names[slot], "r");
+  if (!f) {
+    return false;
+  }
+  if (f.read((uint8_t *)h, sizeof(*h)) != sizeof(*h) ||
+      h->magic != RECORD_MAGIC || h->format != RECORD_FORMAT ||
+      h->len > MAX_STARTUP_ARGS_RECORD ||
+      f.read(payload, h->len) != h->len) {
+    LOGW("config slot %d is truncated", slot);
+    return false;
+  }
+  if (record_crc(*h, payload) != h->crc) {
+    LOGW("config slot %d has bad crc", slot);
+    return false;
+  }
+  return true;
+}
+
+// Loads the newest valid slot; remembers which one it was.
+bool read_record(StartupArgs *args) {
+  uint8_t payload[2][MAX_STARTUP_ARGS_RECORD];
+  RecordHeader h[2];
+  bool valid[2];
+  for (int i = 0; i < 2; ++i) {
+    valid[i] = read_slot(i, &h[i], payload[i]);
+  }
+  int slot = -1;
+  if (valid[0] && valid[1]) {
+    slot = h[1].seq > h[0].seq ? 1 : 0;
+  } else if (valid[0] || valid[1]) {
+    slot = valid[0] ? 0 : 1;
+  }
+  if (slot < 0) {
+    newest_slot = -1;
+    return false;
+  }
+  newest_slot = slot;
+  newest_seq = h[slot].seq;
+  return decode_startup_args(payload[slot], h[slot].len, args);
+}
+
+bool write_record(StartupArgs *args) {
+  uint8_t payload[MAX_STARTUP_ARGS_RECORD];
+  RecordHeader h;
+  h.len = encode_startup_args(args, payload, sizeof(payload));
+  if (h.len == 0) {
+    return false;
+  }
+  if (newest_slot < 0) {
+    // find out which slot not to overwrite
+    StartupArgs tmp;
+    read_record(&tmp);
+  }
+  int slot = newest_slot < 0 ? 0 : newest_slot ^ 1;
+  h.magic = RECORD_MAGIC;
+  h.format = RECORD_FORMAT;
+  h.seq = newest_seq + 1;
+  h.crc = record_crc(h, payload);
+
+  File f = LittleFS.open(slot_file_names[slot], "w");
+  if (!f || f.write((const uint8_t *)&h, sizeof(h)) != sizeof(h) ||
+      f.write(payload, h.len) != h.len) {
+    LOGE("writing config slot %d failed", slot);
+    return false;
+  }
+  f.close();
+  newest_slot = slot;
+  newest_seq = h.seq;
+  LOGD("config written to slot %d, seq %u", slot, unsigned(h.seq));
+  return true;
+}
+
+// keeps a copy for the next warm boot; records over
+// rtc_mem::capacity(CONFIG) (240 bytes) are just not cached
+void cache_record(StartupArgs *args) {
+  uint8_t payload[MAX_STARTUP_ARGS_RECORD];
+  size_t len = encode_startup_args(args, payload, sizeof(payload));
+  if (!len || !rtc_mem::write(rtc_mem::CONFIG, payload, len)) {
+    LOGD("config not cached in rtc memory");
+  }
+}
+
+// Reads the JSON config written by older firmware
+bool import_legacy_config(StartupArgs *args) {
+  File f = LittleFS.open(legacy_config_file_name, "r");
+  if (!f) {
+    return false;
+  }
+  String json;
+  json.reserve(f.size());
+  uint8_t buf[64];
+  size_t n;
+  while ((n = f.read(buf, sizeof(buf))) > 0) {
+    json.concat((const char *)buf, n);
+  }
+  f.close();
+  if (!import_startup_args_json(json.c_str(), args)) {
+    return false;
+  }
+  LOGI("imported legacy json config");
+  if (write_record(args)) {
+    LittleFS.remove(legacy_config_file_name);
+  }
+  return true;
+}
+
 } // namespace
 
-void update_startup_args(IArgsMap &m, StartupArgs *args) {
+namespace {
+
+bool set_args(IArgsMap &m, StartupArgs *args, bool partial) {
+  bool fits = true;
   for (const Arg &a : arg_list) {
     if (!Arg::is_arg(a.type)) {
       continue;
     }
-    String val = m.get(a.id);
-    log("%s <- %s", a.id, val.c_str());
-    args->*(a.val) = m.get(a.id);
+    const char *val = m.get(a.id);
+    if (!val) {
+      if (partial) {
+        continue;
+      }
+      val = "";
+    }
+    LOGD("%s <- %s", a.id, a.type == Arg::SECRET ? REDACTED : val);
+    StrRef dst = a.val(args);
+    if (!dst.assign(val)) {
+      LOGW("%s is longer than %d characters", a.id, int(dst.cap));
+      fits = false;
+    }
   }
+  return fits;
 }
-void read_startup_args(StartupArgs *args) {
-  LittleFSOpener opener;
-  args->ok = false;
-  DynamicJsonDocument json(2048);
-  std::vector<uint8_t> raw;
-  do {
-    {
-      File f = LittleFS.open(config_file_name, "r");
-      raw.resize(f.size() + 1);
-      if (f.read(raw.data(), f.size()) != f.size()) {
-        log("read config file failed");
-        break;
-      }
-      raw[f.size()] = 0;
-      log("config json=[%s]", raw.data());
-      if (deserializeJson(json, raw.data()) != DeserializationError::Ok) {
-        log("json parse failed");
+
+// Points the document to the values, nothing is copied.
+struct JsonArgsWriter : public ArgVisitor {
+  JsonArgsWriter(JsonDocument &doc) : doc(doc) {}
+
+  void arg(const char *id, const char *, const char *val) override {
+    doc[id] = val;
+  }
+
+  void secret(const char *id, const char *, const char *val) override {
+    doc[id] = *val ? REDACTED : "";
+  }
+
+  void title(const char *) override {}
+  void start() override {}
+  void end() override {}
+
+  JsonDocument &doc;
+};
+
+} // namespace
+
+bool update_startup_args(IArgsMap &m, StartupArgs *args) {
+  return set_args(m, args, false);
+}
+
+bool patch_startup_args(IArgsMap &m, StartupArgs *args) {
+  return set_args(m, args, true);
+}
+
+bool is_startup_arg(const char *id) {
+  for (const Arg &a : arg_list) {
+    if (Arg::is_arg(a.type) && strcmp(a.id, id) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void print_startup_args_json(Print &out, StartupArgs *args) {
+  StaticJsonDocument<384> doc;
+  JsonArgsWriter w(doc);
+  visit_args(args, &w);
+  serializeJson(doc, out);
+}
+size_t encode_startup_args(const StartupArgs *args, uint8_t *buf,
+                           size_t cap) {
+  size_t n = 0;
+  for (const Field &f : fields) {
+    StrRef val = f.val(const_cast<StartupArgs *>(args));
+    if (n + 2 + val.length() > cap) {
+      return 0;
+    }
+    buf[n++] = f.tag;
+    buf[n++] = val.length();
+    memcpy(buf + n, val.c_str(), val.length());
+    n += val.length();
+  }
+  return n;
+}
+
+bool decode_startup_args(const uint8_t *buf, size_t len, StartupArgs *args) {
+  *args = StartupArgs();
+  for (size_t n = 0; n < len;) {
+    if (n + 2 > len || n + 2 + buf[n + 1] > len) {
+      return false;
+    }
+    uint8_t tag = buf[n];
+    uint8_t l = buf[n + 1];
+    const char *val = (const char *)buf + n + 2;
+    n += 2 + l;
+    // unknown tags come from newer firmware, skip them
+    for (const Field &f : fields) {
+      if (f.tag == tag) {
+        f.val(args).assign(val, l);
         break;
       }
     }
+  }
+  args->ok = true;
+  return true;
+}
+
+bool import_startup_args_json(const char *json, StartupArgs *args) {
+  StaticJsonDocument<1024> doc;
+  if (deserializeJson(doc, json) != DeserializationError::Ok) {
+    LOGW("json parse failed");
+    return false;
+  }
+  ArgsGetter ag(doc);
+  handle_args(ag, args);
+  if (!ag.fits) {
+    return false;
+  }
+  args->ok = true;
+  return true;
+}
 
-    ArgsGetter ag(json);
-    handle_args(ag, args);
-    args->ok = true;
+void export_startup_args_json(StartupArgs *args, String &out) {
+  StaticJsonDocument<1024> doc;
+  ArgsSetter ag(doc);
+  handle_args(ag, args);
+  serializeJson(doc, out);
+}
+
+void read_startup_args(StartupArgs *args) {
+  // warm boot: the copy in RTC memory spares the mount and the file read
+  uint8_t cached[MAX_STARTUP_ARGS_RECORD];
+  size_t len = rtc_mem::read(rtc_mem::CONFIG, cached, sizeof(cached));
+  if (len && decode_startup_args(cached, len, args)) {
+    LOGD("config loaded from rtc memory");
     return;
-  } while (false);
+  }
 
-  LittleFS.format();
+  LittleFSOpener opener;
+  if (read_record(args) || import_legacy_config(args)) {
+    cache_record(args);
+    return;
+  }
+  // keep whatever else is on the filesystem, just start unconfigured
+  LOGW("no valid config found");
   *args = StartupArgs();
   args->ok = false;
 }
 
 bool write_startup_args(StartupArgs *args) {
+  S28_PROFILE_SCOPE(write_span);
+  // a reset between the two writes must not leave the old copy in RTC
+  // memory, it would win over the new record
+  rtc_mem::invalidate(rtc_mem::CONFIG);
   LittleFSOpener opener;
-  DynamicJsonDocument json(2048);
-  ArgsSetter ag(json);
-  handle_args(ag, args);
-  String s;
-  serializeJson(json, s);
-  log("writing config: %s\n", s.c_str());
-  File f = LittleFS.open(config_file_name, "w");
-  f.write(s.c_str());
+  if (!write_record(args)) {
+    return false;
+  }
+  cache_record(args);
   return true;
 }
 
 void visit_args(StartupArgs *args, ArgVisitor *visitor) {
   visitor->start();
   for (const Arg &a : arg_list) {
+    if (a.type == Arg::SECRET) {
+      visitor->secret(a.id, a.long_name, a.val(args).c_str());
+      continue;
+    }
     if (Arg::is_arg(a.type)) {
-      visitor->arg(a.id, a.long_name, args->*a.val);
+      visitor->arg(a.id, a.long_name, a.val(args).c_str());
       continue;
     }
     switch (a.type) {
@@ -170,7 +454,7 @@ void visit_args(StartupArgs *args, ArgVisitor *visitor) {
     case Arg::SECTION:
       break;
     default:
-      log("warn: something not handled in visit_args");
+      LOGW("something not handled in visit_args");
       break;
     }
   }
@@ -178,22 +462,28 @@ void visit_args(StartupArgs *args, ArgVisitor *visitor) {
 }
 
 struct HtmlFormGenerator : public ArgVisitor {
-  HtmlFormGenerator(String &s) : s(s) {}
-
-  void arg(const String &id, const String &label, const String &val) override {
-    s = s + "<div class=\"label\">" + label + ":</div>" +
-        "<input type=\"text\" name=\"" + id + "\" value=\"" +
-        s28::utils::escape_html(val) + "\"";
-
-    if (id == "ssid") {
-      s += " id=\"ssid\"";
+  HtmlFormGenerator(Print &out) : out(out) {}
+
+  void arg(const char *id, const char *label, const char *val) override {
+    out.print("<div class=\"label\">");
+    out.print(label);
+    out.print(":</div><input type=\"text\" name=\"");
+    out.print(id);
+    out.print("\" value=\"");
+    s28::utils::escape_html(out, val);
+    out.print("\"");
+
+    if (strcmp(id, "ssid") == 0) {
+      out.print(" id=\"ssid\"");
     }
 
-    s += ">\n";
+    out.print(">\n");
   }
 
-  void title(const String &label) override {
-    s = s + "<h1>" + label + "</h1>\n";
+  void title(const char *label) override {
+    out.print("<h1>");
+    out.print(label);
+    out.print("</h1>\n");
   }
 
   void start() override {}
@@ -201,11 +491,11 @@ struct HtmlFormGenerator : public ArgVisitor {
   void end() override {}
 
 private:
-  String &s;
+  Print &out;
 };
 
-void gen_html_form_content(String &s, StartupArgs *args) {
-  HtmlFormGenerator g(s);
+void gen_html_form_content(Print &out, StartupArgs *args) {
+  HtmlFormGenerator g(out);
   visit_args(args, &g);
 }
 } // namespace s28
\ No newline at end of file
@@ -3,29 +3,40 @@
 
 #include <Arduino.h>
 
+#include "fixed_string.h"
+
 namespace s28 {
 
+// All fields are inline with fixed limits, so a StartupArgs never touches
+// the heap. The limits are the binary record's (see the field table in
+// args.cpp); longer input is truncated.
 struct StartupArgs {
   constexpr static const char * VERSION = "1001";
 
-  String version = VERSION;
-  String flags;
-  String ssid;
-  String password;
-  String id;
+  FixedString<8> version = VERSION;
+  FixedString<4> flags;
+  FixedString<32> ssid;
+  FixedString<64> password;
+  FixedString<32> id;
   
-  String collector; // blynk server
-  String token;
-  String fingerprint; // blybk server fingerprint
+  FixedString<64> collector; // blynk server
+  FixedString<64> token;
+  FixedString<59> fingerprint; // blybk server fingerprint
+
+  // optional static network config, DHCP when ip is empty
+  FixedString<15> ip;
+  FixedString<15> gateway;
+  FixedString<15> netmask;
+  FixedString<15> dns;
 
-  bool has_custom_blynk_server() {
+  bool has_custom_blynk_server() const {
     if (collector.isEmpty() || collector == "*") {
       return false;
     }
     return true;
   }
 
-  bool is_entering_setup() {
+  bool is_entering_setup() const {
     if (flags ==  "1") {
       return true;
     }
@@ -46,20 +57,43 @@ struct StartupArgs {
 
 
 struct ArgVisitor {
-  virtual void arg(const String &id, const String &label, const String &val) = 0;
-  virtual void title(const String &label) = 0;
+  virtual void arg(const char *id, const char *label, const char *val) = 0;
+  // password and token; plain args unless the visitor hides them
+  virtual void secret(const char *id, const char *label, const char *val) {
+    arg(id, label, val);
+  }
+  virtual void title(const char *label) = 0;
   virtual void start() = 0;
   virtual void end() = 0;
 };
 
 struct IArgsMap {
-  virtual String get(const char *name) = 0;
+  // the value stays valid until the next call, nullptr when not set
+  virtual const char *get(const char *name) = 0;
 };
 
+// what the JSON API shows instead of a secret that is set
+constexpr const char *REDACTED = "********";
+
+// largest binary config record payload
+constexpr size_t MAX_STARTUP_ARGS_RECORD = 400;
+
 void read_startup_args(StartupArgs *args);
 bool write_startup_args(StartupArgs *args);
-void gen_html_form_content(String &s, StartupArgs *args);
-void update_startup_args(IArgsMap &m, StartupArgs *args);
+size_t encode_startup_args(const StartupArgs *args, uint8_t *buf, size_t cap);
+bool decode_startup_args(const uint8_t *buf, size_t len, StartupArgs *args);
+// False if the json is invalid or a value is too long.
+bool import_startup_args_json(const char *json, StartupArgs *args);
+void export_startup_args_json(StartupArgs *args, String &out);
+// prints the form fields, nothing is allocated
+void gen_html_form_content(Print &out, StartupArgs *args);
+// False if a value was too long (it is stored truncated).
+bool update_startup_args(IArgsMap &m, StartupArgs *args);
+// Same, but sets only the args `m` has.
+bool patch_startup_args(IArgsMap &m, StartupArgs *args);
+bool is_startup_arg(const char *id);
+// {"ssid": ..., "password": "********", ...}, secrets redacted
+void print_startup_args_json(Print &out, StartupArgs *args);
 void visit_args(StartupArgs *args, ArgVisitor *visitor);
 
 }
@@ -0,0 +1,82 @@
+#include "console.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace s28 {
+namespace console {
+
+namespace {
+
+struct Command {
+  const char *name;
+  const char *help;
+  Handler fn;
+};
+
+Command commands[MAX_COMMANDS];
+int command_count = 0;
+
+char line[64];
+size_t line_len = 0;
+bool overflow = false;
+
+void help(const char *) {
+  for (int i = 0; i < command_count; ++i) {
+    Serial.printf("%-10s %s\n", commands[i].name, commands[i].help);
+  }
+}
+
+void run(char *cmd) {
+  char *args = strchr(cmd, ' ');
+  if (args) {
+    *args++ = 0;
+  } else {
+    args = cmd + strlen(cmd);
+  }
+  if (!*cmd) {
+    return;
+  }
+  if (strcmp(cmd, "help") == 0) {
+    help(args);
+    return;
+  }
+  for (int i = 0; i < command_count; ++i) {
+    if (strcmp(cmd, commands[i].name) == 0) {
+      commands[i].fn(args);
+      return;
+    }
+  }
+  Serial.printf("unknown command: %s, try help\n", cmd);
+}
+
+} // namespace
+
+bool add(const char *name, const char *help, Handler fn) {
+  if (command_count == MAX_COMMANDS) {
+    return false;
+  }
+  commands[command_count++] = {name, help, fn};
+  return true;
+}
+
+void loop() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      line[line_len] = 0;
+      if (!overflow) {
+        run(line);
+      }
+      line_len = 0;
+      overflow = false;
+    } else if (line_len + 1 < sizeof(line)) {
+      line[line_len++] = c;
+    } else {
+      overflow = true;
+    }
+  }
+}
+
+} // namespace console
+} // namespace s28
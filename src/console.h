@@ -0,0 +1,22 @@
+#ifndef s28_console_h
+#define s28_console_h
+
+namespace s28 {
+namespace console {
+
+// Line based commands on the serial port, e.g. "latency". Replies go
+// straight to Serial, not to the log.
+typedef void (*Handler)(const char *args);
+
+constexpr int MAX_COMMANDS = 8;
+
+// `name` and `help` must be static strings
+bool add(const char *name, const char *help, Handler fn);
+
+// Reads what the serial port has, never waits; runs complete lines.
+void loop();
+
+} // namespace console
+} // namespace s28
+
+#endif
@@ -1,182 +1,42 @@
 #include <ESP8266WiFi.h> // https://github.com/esp8266/Arduino
 #include <WiFiClient.h>  // https://github.com/esp8266/Arduino
-#include <bearssl/bearssl.h>
 
 #include "fingerprint_probe.h"
 
-namespace {
+#include "logging.h"
+#include "probe_engine.h"
 
-struct ex_context {
-  const br_x509_class *vtable;
-  br_multihash_context mhash;
-  br_sha1_context sha1_cert;
-  bool done_cert = false;
-  uint8_t *fingerprint;
-  bool ok = false;
-};
+S28_LOG_MODULE(PROBE, "probe")
 
-int sock_read(void *ctx, unsigned char *buf, size_t len) {
-  WiFiClient *client = (WiFiClient *)ctx;
+using namespace s28;
 
-  int retr = 0;
-  while (client->available() == 0) {
-    delay(10);
-    retr++;
-    if (retr == 500) {
-      Serial.printf("fingerprint-probe: socket_read failed!\n");
-      return -1;
-    }
-  }
+namespace {
 
-  Serial.printf("reading %d bytes:\n", (int)len);
-  for (size_t i = 0; i < len; i++) {
-    int x;
-    retr = 0;
+struct ClientTransport : public probe::Transport {
+  explicit ClientTransport(WiFiClient &client) : client(client) {}
 
-    for (;;) {
-      x = client->read();
-      if (x != -1)
-        break;
-      if (retr > 20) {
-        return -1;
-      }
-      delay(10);
-      retr++;
+  int read(unsigned char *buf, size_t len) override {
+    int avail = client.available();
+    if (avail <= 0) {
+      return client.connected() ? 0 : -1;
     }
-
-    buf[i] = x;
+    return client.read(buf, std::min(len, size_t(avail)));
   }
 
-  return len;
-}
-
-int sock_write(void *ctx, const unsigned char *buf, size_t len) {
-  WiFiClient *client = (WiFiClient *)ctx;
-  int rv = client->write(buf, len);
-  client->flush();
-  return rv;
-}
-
-const br_x509_pkey *get_pkey(const br_x509_class *const *ctx,
-                             unsigned *usages) {
-  return 0;
-}
-
-static void ex_start_chain(const br_x509_class **ctx, const char *server_name) {
-  ex_context *xc = (ex_context *)ctx;
-  br_sha1_init(&xc->sha1_cert);
-}
-
-static void ex_append(const br_x509_class **ctx, const unsigned char *buf,
-                      size_t len) {
-  ex_context *xc = (ex_context *)ctx;
-  if (xc->done_cert)
-    return;
-  br_sha1_update(&xc->sha1_cert, buf, len);
-  xc->ok = true;
-}
-
-static void ex_end_cert(const br_x509_class **ctx) {
-  ex_context *xc = (ex_context *)ctx;
-  xc->done_cert = true;
-  uint8_t res[20];
-  memset(res, 0, sizeof(res));
-  br_sha1_out(&xc->sha1_cert, res);
-  memcpy(xc->fingerprint, res, 20);
-}
-
-unsigned end_chain(const br_x509_class **ctx) {
-  return BR_ERR_X509_NOT_TRUSTED;
-}
-
-void start_cert(const br_x509_class **ctx, uint32_t length) {}
-
-void br_ssl_client_init_full2(br_ssl_client_context *cc, ex_context *xc,
-                              const br_x509_trust_anchor *trust_anchors,
-                              size_t trust_anchors_num) {
-  static const uint16_t suites[] = {
-      BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
-      BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
-      BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384,
-      BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_128_CCM,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_256_CCM,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_256_CCM_8,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256,
-      BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_256_CBC_SHA384,
-      BR_TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA384,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA,
-      BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA,
-      BR_TLS_ECDHE_ECDSA_WITH_AES_256_CBC_SHA,
-      BR_TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA,
-      BR_TLS_ECDH_ECDSA_WITH_AES_128_GCM_SHA256,
-      BR_TLS_ECDH_RSA_WITH_AES_128_GCM_SHA256,
-      BR_TLS_ECDH_ECDSA_WITH_AES_256_GCM_SHA384,
-      BR_TLS_ECDH_RSA_WITH_AES_256_GCM_SHA384,
-      BR_TLS_ECDH_ECDSA_WITH_AES_128_CBC_SHA256,
-      BR_TLS_ECDH_RSA_WITH_AES_128_CBC_SHA256,
-      BR_TLS_ECDH_ECDSA_WITH_AES_256_CBC_SHA384,
-      BR_TLS_ECDH_RSA_WITH_AES_256_CBC_SHA384,
-      BR_TLS_ECDH_ECDSA_WITH_AES_128_CBC_SHA,
-      BR_TLS_ECDH_RSA_WITH_AES_128_CBC_SHA,
-      BR_TLS_ECDH_ECDSA_WITH_AES_256_CBC_SHA,
-      BR_TLS_ECDH_RSA_WITH_AES_256_CBC_SHA,
-      BR_TLS_RSA_WITH_AES_128_GCM_SHA256,
-      BR_TLS_RSA_WITH_AES_256_GCM_SHA384,
-      BR_TLS_RSA_WITH_AES_128_CCM,
-      BR_TLS_RSA_WITH_AES_256_CCM,
-      BR_TLS_RSA_WITH_AES_128_CCM_8,
-      BR_TLS_RSA_WITH_AES_256_CCM_8,
-      BR_TLS_RSA_WITH_AES_128_CBC_SHA256,
-      BR_TLS_RSA_WITH_AES_256_CBC_SHA256,
-      BR_TLS_RSA_WITH_AES_128_CBC_SHA,
-      BR_TLS_RSA_WITH_AES_256_CBC_SHA,
-      BR_TLS_ECDHE_ECDSA_WITH_3DES_EDE_CBC_SHA,
-      BR_TLS_ECDHE_RSA_WITH_3DES_EDE_CBC_SHA,
-      BR_TLS_ECDH_ECDSA_WITH_3DES_EDE_CBC_SHA,
-      BR_TLS_ECDH_RSA_WITH_3DES_EDE_CBC_SHA,
-      BR_TLS_RSA_WITH_3DES_EDE_CBC_SHA};
-
-  static const br_hash_class *hashes[] = {&br_md5_vtable,    &br_sha1_vtable,
-                                          &br_sha224_vtable, &br_sha256_vtable,
-                                          &br_sha384_vtable, &br_sha512_vtable};
-
-  br_ssl_client_zero(cc);
-  br_ssl_engine_set_versions(&cc->eng, BR_TLS10, BR_TLS12);
-
-  memset(xc, 0, sizeof(*xc));
-
-  br_ssl_engine_set_suites(&cc->eng, suites,
-                           (sizeof suites) / (sizeof suites[0]));
-
-  for (int id = br_md5_ID; id <= br_sha512_ID; id++) {
-    const br_hash_class *hc;
-
-    hc = hashes[id - 1];
-    br_ssl_engine_set_hash(&cc->eng, id, hc);
-    br_multihash_setimpl(&xc->mhash, id, hc);
+  int write(const unsigned char *buf, size_t len) override {
+    if (!client.connected()) {
+      return -1;
+    }
+    return client.write(buf, std::min(len, client.availableForWrite()));
   }
 
-  br_ssl_engine_set_x509(&cc->eng, &xc->vtable);
-}
-
-struct HeapVars {
-  static const size_t iobuf_len = 837;
-  br_ssl_client_context sc;
-  ex_context xc;
-  unsigned char iobuf[iobuf_len];
-  br_sslio_context ioc;
-  WiFiClient client;
+  WiFiClient &client;
 };
 
 char hex(int a) {
   static const char *h = "0123456789ABCDEF";
   if (a < 0 || a > 15) {
-    Serial.printf("FATAL! hex failed\n");
+    LOGE("FATAL! hex failed");
     for (;;) {
       delay(1000);
     }
@@ -188,54 +48,85 @@ char hex(int a) {
 
 namespace s28 {
 
-int probe(const String &host, int port, Fingerprint *fp) {
-  std::unique_ptr<HeapVars> vars(new HeapVars());
-
-  for (int retr = 1;; ++retr) {
-    if (!vars->client.connect(host, port)) {
-      Serial.printf("Failed connection... %s %d; attempt=%d\n", host.c_str(),
-                    port, retr);
-      vars->client.stopAll();
-      if (retr == 15) {
-        Serial.printf("probe, giving up on connection :-(");
-        return -1;
-      }
-      delay(2000);
-      continue;
-    }
-    break;
-  }
+struct Probe::Vars {
+  probe::Engine engine;
+  WiFiClient client;
+};
 
-  Serial.printf("looking for fingerprint...%s %d\n", host.c_str(), port);
-  br_ssl_client_context &sc(vars->sc);
-  ex_context &xc(vars->xc);
-  br_sslio_context &ioc(vars->ioc);
+Probe::Probe(const char *host, int port, Fingerprint *fp)
+    : host(host), port(port), fp(fp), vars(new Vars()) {}
 
-  br_ssl_client_init_full2(&sc, &xc, 0, 0);
+Probe::~Probe() { vars->client.stop(); }
 
-  br_x509_class vtable;
-  xc.vtable = &vtable;
-  vtable.start_cert = start_cert;
-  vtable.start_chain = ex_start_chain;
-  vtable.append = ex_append;
-  vtable.end_cert = ex_end_cert;
-  vtable.get_pkey = get_pkey;
-  vtable.end_chain = end_chain;
+Probe::Status Probe::step() {
+  switch (state) {
+  case CONNECT:
+    return connect();
+  case HANDSHAKE:
+    return handshake();
+  case FINISHED:
+    break;
+  }
+  return status;
+}
 
-  vars->xc.fingerprint = fp->raw;
+Probe::Status Probe::finish(Status s) {
+  vars->client.stop();
+  state = FINISHED;
+  status = s;
+  return s;
+}
 
-  br_ssl_engine_set_buffer(&sc.eng, vars->iobuf, HeapVars::iobuf_len, 0);
-  br_ssl_client_reset(&sc, host.c_str(), 0);
-  br_sslio_init(&ioc, &sc.eng, sock_read, &vars->client, sock_write,
-                &vars->client);
-  br_sslio_flush(&ioc);
+Probe::Status Probe::connect() {
+  if (int32_t(millis() - next_attempt) < 0) {
+    return PENDING;
+  }
+  ++attempts;
+  // bounds the blocking part of connect()
+  vars->client.setTimeout(connect_timeout);
+  if (!vars->client.connect(host, port)) {
+    LOGW("Failed connection... %s %d; attempt=%d, timeout %u ms", host, port,
+         attempts, unsigned(connect_timeout));
+    vars->client.stop();
+    connect_timeout *= 2;
+    if (connect_timeout > MAX_CONNECT_TIMEOUT) {
+      connect_timeout = MAX_CONNECT_TIMEOUT;
+    }
+    if (attempts == MAX_ATTEMPTS) {
+      LOGE("probe, giving up on connection :-(");
+      return finish(FAILED);
+    }
+    next_attempt = millis() + RETRY_INTERVAL;
+    return PENDING;
+  }
 
-  int err = br_ssl_engine_last_error(&sc.eng);
+  LOGI("looking for fingerprint...%s %d", host, port);
+  vars->client.setNoDelay(true);
+  started = millis();
+  vars->engine.start(host, fp->raw, started, HANDSHAKE_TIMEOUT);
+  state = HANDSHAKE;
+  return PENDING;
+}
 
-  if (err == 62 && xc.ok) {
-    return 0;
+Probe::Status Probe::handshake() {
+  ClientTransport transport(vars->client);
+  probe::Engine &engine(vars->engine);
+  switch (engine.step(transport, millis())) {
+  case probe::PENDING:
+    return PENDING;
+  case probe::OK:
+    LOGD("probe done in %u ms, %u bytes in, %u out",
+         unsigned(millis() - started), unsigned(engine.bytes_in),
+         unsigned(engine.bytes_out));
+    return finish(OK);
+  case probe::TIMEOUT:
+    LOGW("probe timed out after %u bytes", unsigned(engine.bytes_in));
+    return finish(FAILED);
+  case probe::FAILED:
+    break;
   }
-  return -1;
+  LOGW("probe failed, error %d", engine.last_error());
+  return finish(FAILED);
 }
 
 String Fingerprint::to_string() {
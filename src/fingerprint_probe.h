@@ -1,6 +1,9 @@
 #ifndef fingerprint_probe_h
 #define fingerprint_probe_h
 
+#include <Arduino.h>
+#include <memory>
+
 namespace s28 {
 
 struct Fingerprint {
@@ -8,8 +11,47 @@ struct Fingerprint {
     String to_string();
 };
 
-int probe(const String &host, int port, Fingerprint *fp);
+// Reads the SHA-1 fingerprint of the server certificate. Call step() from a
+// scheduler task until it returns something else than PENDING. A step does
+// at most one connect attempt or moves what the socket has at the moment;
+// see probe::Engine. WiFiClient has no asynchronous connect, so an attempt
+// blocks for its timeout: FIRST_CONNECT_TIMEOUT, doubled after every failed
+// attempt up to MAX_CONNECT_TIMEOUT for servers that answer slowly.
+struct Probe {
+  enum Status { PENDING, OK, FAILED };
+
+  static constexpr int MAX_ATTEMPTS = 15;
+  static constexpr uint32_t RETRY_INTERVAL = 2000;
+  static constexpr uint32_t FIRST_CONNECT_TIMEOUT = 300;
+  static constexpr uint32_t MAX_CONNECT_TIMEOUT = 2000;
+  static constexpr uint32_t HANDSHAKE_TIMEOUT = 5000;
+
+  // `host` must outlive the probe
+  Probe(const char *host, int port, Fingerprint *fp);
+  ~Probe();
+
+  Status step();
+
+private:
+  enum State { CONNECT, HANDSHAKE, FINISHED };
+  struct Vars;
+
+  Status connect();
+  Status handshake();
+  Status finish(Status s);
+
+  const char *host;
+  int port;
+  Fingerprint *fp;
+  std::unique_ptr<Vars> vars; // BearSSL context, ~4 KB
+  State state = CONNECT;
+  Status status = PENDING;
+  int attempts = 0;
+  uint32_t connect_timeout = FIRST_CONNECT_TIMEOUT;
+  uint32_t next_attempt = 0;
+  uint32_t started = 0;
+};
 
 } // namespace s28
 
-#endif /* fingerprint_probe_h */
\ No newline at end of file
+#endif /* fingerprint_probe_h */
@@ -0,0 +1,64 @@
+#ifndef s28_fixed_string_h
+#define s28_fixed_string_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace s28 {
+
+// A FixedString of any capacity, for code that treats all of them alike
+// (the config field tables).
+struct StrRef {
+  char *buf;
+  uint8_t *len;
+  uint8_t cap;
+
+  const char *c_str() const { return buf; }
+  size_t length() const { return *len; }
+
+  // Copies at most `cap` characters; false if `s` had to be truncated.
+  bool assign(const char *s, size_t n) {
+    bool fits = n <= cap;
+    if (!fits) {
+      n = cap;
+    }
+    memmove(buf, s, n);
+    buf[n] = 0;
+    *len = n;
+    return fits;
+  }
+  bool assign(const char *s) { return assign(s, strlen(s)); }
+};
+
+// Inline string of at most N characters, always terminated, no heap.
+template <size_t N> struct FixedString {
+  static_assert(N < 256, "the length is kept in a byte");
+  static constexpr size_t CAPACITY = N;
+
+  FixedString() {}
+  FixedString(const char *s) { assign(s); }
+
+  FixedString &operator=(const char *s) {
+    assign(s);
+    return *this;
+  }
+
+  const char *c_str() const { return buf; }
+  size_t length() const { return len; }
+  bool isEmpty() const { return len == 0; }
+  bool operator==(const char *s) const { return strcmp(buf, s) == 0; }
+  bool operator!=(const char *s) const { return !(*this == s); }
+
+  bool assign(const char *s, size_t n) { return ref().assign(s, n); }
+  bool assign(const char *s) { return ref().assign(s); }
+
+  StrRef ref() { return {buf, &len, uint8_t(N)}; }
+
+  char buf[N + 1] = {0};
+  uint8_t len = 0;
+};
+
+} // namespace s28
+
+#endif
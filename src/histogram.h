@@ -0,0 +1,92 @@
+#ifndef s28_histogram_h
+#define s28_histogram_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace s28 {
+
+// Fixed-memory histogram of non-negative values (e.g. microseconds).
+// Buckets are log2 with 4 linear steps per power of two, so a percentile
+// is off by at most 25% of its value; values up to 3 are exact. Values
+// above 2^26 fall into the last bucket.
+struct Histogram {
+  static constexpr int SUB_BITS = 2;
+  static constexpr int SUB = 1 << SUB_BITS;
+  static constexpr int MAX_BITS = 26;
+  static constexpr int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB + SUB;
+
+  uint32_t counts[BUCKETS];
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+
+  Histogram() { reset(); }
+
+  void reset() {
+    memset(counts, 0, sizeof(counts));
+    count = 0;
+    min = UINT32_MAX;
+    max = 0;
+    sum = 0;
+  }
+
+  void add(uint32_t v) {
+    counts[bucket(v)]++;
+    count++;
+    sum += v;
+    if (v < min) {
+      min = v;
+    }
+    if (v > max) {
+      max = v;
+    }
+  }
+
+  uint32_t mean() const { return count ? uint32_t(sum / count) : 0; }
+
+  // Upper bound of the bucket holding the given fraction (in 1/1000) of the
+  // values, capped by the maximum; 0 when empty.
+  uint32_t percentile(uint32_t permille) const {
+    if (!count) {
+      return 0;
+    }
+    uint64_t rank = (uint64_t(count) * permille + 999) / 1000;
+    if (rank == 0) {
+      rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+      seen += counts[b];
+      if (seen >= rank) {
+        uint32_t u = upper(b);
+        return u < max ? u : max;
+      }
+    }
+    return max;
+  }
+
+  static int bucket(uint32_t v) {
+    if (v < SUB) {
+      return v;
+    }
+    int msb = 31 - __builtin_clz(v);
+    int b = (msb - SUB_BITS + 1) * SUB + ((v >> (msb - SUB_BITS)) & (SUB - 1));
+    return b < BUCKETS ? b : BUCKETS - 1;
+  }
+
+  static uint32_t upper(int b) {
+    if (b < SUB) {
+      return b;
+    }
+    int msb = b / SUB - 1 + SUB_BITS;
+    uint32_t step = uint32_t(1) << (msb - SUB_BITS);
+    return uint32_t(SUB + b % SUB) * step + step - 1;
+  }
+};
+
+} // namespace s28
+
+#endif
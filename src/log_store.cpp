@@ -0,0 +1,210 @@
+#include "log_store.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "lz.h"
+#include "utils.h"
+
+namespace s28 {
+namespace log_store {
+
+namespace {
+
+constexpr uint32_t SEGMENT_MAGIC = 0x4c383253; // "S28L"
+constexpr uint8_t BLOCK_MAGIC = 0xb5;
+constexpr uint8_t BLOCK_COMPRESSED = 0x01;
+constexpr uint32_t FLUSH_INTERVAL = 10000;
+
+struct SegmentHeader {
+  uint32_t magic;
+  uint32_t seq;
+  uint16_t boot;
+  uint16_t reserved;
+} __attribute__((packed));
+
+struct BlockHeader {
+  uint8_t magic;
+  uint8_t flags;
+  uint16_t raw_len;
+  uint16_t data_len;
+  uint16_t boot;
+  uint32_t crc; // of the stored data
+} __attribute__((packed));
+
+static_assert(BLOCK_SIZE <= lz::MAX_BLOCK, "block too large for lz");
+
+// two batch buffers, one can be written while the other fills
+struct Batch {
+  uint8_t data[BLOCK_SIZE];
+  size_t len = 0;
+  bool full = false;
+};
+
+Batch batches[2];
+int active = 0;
+uint32_t batch_started = 0;
+uint32_t seq = 0;
+bool started = false;
+Stats st = {};
+
+String file_name(uint32_t seq) {
+  return String("/logs.") + String(unsigned(seq % SEGMENTS));
+}
+
+bool read_header(File &f, SegmentHeader *h) {
+  return f.read((uint8_t *)h, sizeof(*h)) == sizeof(*h) &&
+         h->magic == SEGMENT_MAGIC;
+}
+
+// Walks the blocks of a segment. Returns false if the segment ends with a
+// torn block.
+bool scan_blocks(File &f, uint16_t *max_boot) {
+  BlockHeader b;
+  while (f.available()) {
+    if (f.read((uint8_t *)&b, sizeof(b)) != sizeof(b) ||
+        b.magic != BLOCK_MAGIC || size_t(f.available()) < b.data_len) {
+      return false;
+    }
+    if (b.boot > *max_boot) {
+      *max_boot = b.boot;
+    }
+    f.seek(b.data_len, SeekCur);
+  }
+  return true;
+}
+
+File open_segment(bool rotate) {
+  if (rotate) {
+    seq++;
+    File f = LittleFS.open(file_name(seq), "w");
+    if (f) {
+      SegmentHeader h = {SEGMENT_MAGIC, seq, uint16_t(st.boot), 0};
+      f.write((const uint8_t *)&h, sizeof(h));
+    }
+    return f;
+  }
+  return LittleFS.open(file_name(seq), "a");
+}
+
+void write_block(Batch &b) {
+  static uint8_t packed[BLOCK_SIZE];
+  BlockHeader h;
+  h.magic = BLOCK_MAGIC;
+  h.boot = st.boot;
+  h.raw_len = b.len;
+
+  const uint8_t *data = packed;
+  size_t n = lz::compress(b.data, b.len, packed, sizeof(packed));
+  h.flags = BLOCK_COMPRESSED;
+  if (n == 0 || n >= b.len) {
+    data = b.data;
+    n = b.len;
+    h.flags = 0;
+  }
+  h.data_len = n;
+  h.crc = utils::crc32(data, n);
+
+  File f = open_segment(false);
+  if (!f || f.size() + sizeof(h) + n > SEGMENT_SIZE) {
+    f.close();
+    f = open_segment(true);
+  }
+  if (f) {
+    f.write((const uint8_t *)&h, sizeof(h));
+    f.write(data, n);
+    st.blocks_written++;
+    st.raw_bytes += b.len;
+    st.stored_bytes += sizeof(h) + n;
+  }
+  b.len = 0;
+  b.full = false;
+}
+
+} // namespace
+
+uint32_t begin() {
+  utils::LittleFSOpener opener;
+  bool found = false;
+  uint16_t boot = 0;
+  for (size_t i = 0; i < SEGMENTS; ++i) {
+    File f = LittleFS.open(file_name(i), "r");
+    SegmentHeader h;
+    if (!f || !read_header(f, &h)) {
+      continue;
+    }
+    if (!found || h.seq > seq) {
+      seq = h.seq;
+      found = true;
+    }
+  }
+
+  bool rotate = !found;
+  if (found) {
+    File f = LittleFS.open(file_name(seq), "r");
+    SegmentHeader h;
+    read_header(f, &h);
+    boot = h.boot;
+    // never append behind a torn block, start a fresh segment instead
+    rotate = !scan_blocks(f, &boot);
+  }
+  st.boot = uint16_t(boot + 1);
+  if (rotate) {
+    open_segment(true);
+  }
+  started = true;
+  return st.boot;
+}
+
+void append(const char *data, size_t len) {
+  if (len + 1 > BLOCK_SIZE) {
+    len = BLOCK_SIZE - 1;
+  }
+  Batch *b = &batches[active];
+  if (b->len + len + 1 > BLOCK_SIZE) {
+    b->full = true;
+    Batch &other = batches[active ^ 1];
+    if (other.full || other.len) {
+      st.dropped_records++;
+      return;
+    }
+    active ^= 1;
+    b = &other;
+  }
+  if (b->len == 0) {
+    batch_started = millis();
+  }
+  memcpy(b->data + b->len, data, len);
+  b->data[b->len + len] = '\n';
+  b->len += len + 1;
+}
+
+void flush() {
+  if (!started) {
+    return;
+  }
+  utils::LittleFSOpener opener;
+  // the full buffer is the older one
+  Batch &older = batches[active ^ 1];
+  if (older.len) {
+    write_block(older);
+  }
+  if (batches[active].len) {
+    write_block(batches[active]);
+  }
+}
+
+void loop() {
+  Batch &b = batches[active];
+  if (batches[active ^ 1].len || b.full ||
+      (b.len && millis() - batch_started > FLUSH_INTERVAL)) {
+    flush();
+  }
+}
+
+Stats stats() { return st; }
+
+String segment_name(size_t i) { return file_name(seq + 1 + i); }
+
+} // namespace log_store
+} // namespace s28
@@ -0,0 +1,53 @@
+#ifndef s28_log_store_h
+#define s28_log_store_h
+
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace log_store {
+
+// Persistent log on LittleFS that survives reboots and crashes.
+//
+// Records are batched in RAM and written as compressed, CRC protected
+// blocks appended to fixed-size segment files (/logs.0 .. /logs.N-1). The
+// oldest segment is reused when the newest one is full, so the store never
+// takes more than SEGMENTS * SEGMENT_SIZE bytes. A block torn by a reset is
+// skipped by the reader. Decode a dump with tools/log_store.py.
+
+constexpr size_t SEGMENTS = 6;
+constexpr size_t SEGMENT_SIZE = 4096;
+constexpr size_t BLOCK_SIZE = 512; // batch size before compression
+
+// Finds the newest segment and starts a new boot. Returns the boot number.
+uint32_t begin();
+
+// Queues one record. Never touches the filesystem, so it is safe to call
+// from anywhere, including code that holds the filesystem.
+void append(const char *data, size_t len);
+
+// Writes the queued records; called from the main loop.
+void flush();
+
+// Flushes when a full block is waiting or the batch is older than a few
+// seconds.
+void loop();
+
+struct Stats {
+  uint32_t boot;
+  uint32_t blocks_written;
+  uint32_t raw_bytes;
+  uint32_t stored_bytes;
+  uint32_t dropped_records; // both batch buffers were full
+};
+Stats stats();
+
+// File name of the i-th oldest segment (0 <= i < SEGMENTS); the file may
+// not exist yet.
+String segment_name(size_t i);
+
+} // namespace log_store
+} // namespace s28
+
+#endif
@@ -3,27 +3,44 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <LittleFS.h>
+#include "log_store.h"
+#include "logging.h"
 #include "utils.h"
 namespace s28 {
 
+#ifndef S28_LOG_HISTORY_SIZE
+#define S28_LOG_HISTORY_SIZE 3072
+#endif
+
 namespace {
+
+// Log records of the current boot kept in a fixed arena. When the arena is
+// full the oldest records are overwritten, so the newest ones survive.
 struct History {
-  History() {}
+  struct Header {
+    uint16_t len; // text length
+    uint32_t seq;
+    uint32_t ts; // millis()
+  } __attribute__((packed));
 
-  ~History() {
-    for (char *rec : history) {
-      free(rec);
-    }
-  }
+  static constexpr size_t SIZE = S28_LOG_HISTORY_SIZE;
 
-  void insert(const char *msg) {
-    if (history.size() > 200) {
-      return;
+  void insert(const char *msg, size_t len) {
+    if (len > SIZE - sizeof(Header)) {
+      len = SIZE - sizeof(Header);
     }
-    char *buf = strdup(msg);
-    if (buf) {
-      history.push_back(buf);
+    size_t rec = sizeof(Header) + len;
+    while (SIZE - used < rec) {
+      drop_oldest();
     }
+
+    Header h;
+    h.len = len;
+    h.seq = seq++;
+    h.ts = millis();
+    put((const uint8_t *)&h, sizeof(h));
+    put((const uint8_t *)msg, len);
+    used += rec;
   }
 
   void flush() {
@@ -33,40 +50,249 @@ struct History {
       Serial.printf("failed to open little file /log\n");
       return;
     }
-    for (char *c: history) {
-      f.println(c);
+    if (dropped) {
+      f.printf("... %u older records dropped\n", unsigned(dropped));
+    }
+    for (size_t pos = head, left = used; left;) {
+      Header h;
+      get(pos, (uint8_t *)&h, sizeof(h));
+      pos = (pos + sizeof(h)) % SIZE;
+      f.printf("#%u %lu.%03lu ", unsigned(h.seq), (unsigned long)h.ts / 1000,
+               (unsigned long)h.ts % 1000);
+      // the text may wrap around the end of the arena
+      size_t n = std::min<size_t>(h.len, SIZE - pos);
+      f.write(arena + pos, n);
+      f.write(arena, h.len - n);
+      f.write('\n');
+      pos = (pos + h.len) % SIZE;
+      left -= sizeof(h) + h.len;
     }
     f.flush();
     f.close();
     Serial.println("Log written\n");
   }
 
+  void clear() {
+    head = 0;
+    tail = 0;
+    used = 0;
+    dropped = 0;
+  }
+
 private:
-  std::vector<char *> history;
-  size_t n = 0;
+  void put(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      arena[tail] = data[i];
+      tail = tail + 1 == SIZE ? 0 : tail + 1;
+    }
+  }
+
+  void get(size_t pos, uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      data[i] = arena[pos];
+      pos = pos + 1 == SIZE ? 0 : pos + 1;
+    }
+  }
+
+  void drop_oldest() {
+    Header h;
+    get(head, (uint8_t *)&h, sizeof(h));
+    size_t rec = sizeof(h) + h.len;
+    head = (head + rec) % SIZE;
+    used -= rec;
+    dropped++;
+  }
+
+  uint8_t arena[SIZE];
+  size_t head = 0; // oldest record
+  size_t tail = 0; // next write
+  size_t used = 0;
+  uint32_t seq = 0;
+  uint32_t dropped = 0;
 };
 
 bool history_enabled = true;
-History *log_history = nullptr;
+History log_history;
+int runtime_level = S28_LOG_DEBUG;
+
+#ifdef S28_LOG_BINARY
+// Binary log record, nothing is formatted on the device:
+//   0x1e | len | format address (4) | millis (4) | level (1) |
+//   tag address (4) | args | sum
+// len counts the bytes between len and sum, sum is their 8-bit sum.
+// Integers take 4 bytes (8 for %ll), floating point 8 bytes and strings a
+// length byte followed by the text. tools/log_decode.py turns the records
+// back into text using the firmware ELF.
+constexpr uint8_t BINARY_SYNC = 0x1e;
+constexpr size_t BINARY_MAX = 255;
+constexpr size_t BINARY_MAX_STR = 48;
+
+struct BinaryRecord {
+  uint8_t buf[BINARY_MAX + 3];
+  size_t len = 2;
+  bool overflow = false;
+
+  void put(const void *data, size_t n) {
+    if (overflow || len - 2 + n > BINARY_MAX) {
+      overflow = true;
+      return;
+    }
+    memcpy(buf + len, data, n);
+    len += n;
+  }
+
+  void put32(uint32_t v) { put(&v, sizeof(v)); }
+  void put64(uint64_t v) { put(&v, sizeof(v)); }
+
+  void put_str(const char *s) {
+    if (!s) {
+      s = "(null)";
+    }
+    size_t n = strnlen(s, BINARY_MAX_STR);
+    uint8_t l = n;
+    put(&l, 1);
+    put(s, n);
+  }
+
+  size_t finish() {
+    buf[0] = BINARY_SYNC;
+    buf[1] = len - 2;
+    uint8_t sum = 0;
+    for (size_t i = 2; i < len; ++i) {
+      sum += buf[i];
+    }
+    buf[len++] = sum;
+    return len;
+  }
+};
+
+bool is_flag(char c) {
+  return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
 
-void log_(int lvl, const char *format, va_list a) {
-  if (history_enabled && log_history == 0) {
-    log_history = new History();
+// walks the conversions of `format` and stores the raw arguments
+void encode_args(BinaryRecord &r, const char *format, va_list &arg) {
+  // the format lives in flash, it can only be read with pgm_read_byte
+  char c;
+  const char *p = format;
+  auto next = [&p, &c]() { c = pgm_read_byte(p++); };
+  for (next(); c; next()) {
+    if (c != '%') {
+      continue;
+    }
+    next();
+    if (c == '%') {
+      continue;
+    }
+    while (is_flag(c)) {
+      next();
+    }
+    if (c == '*') {
+      r.put32(va_arg(arg, int));
+      next();
+    }
+    while (c >= '0' && c <= '9') {
+      next();
+    }
+    if (c == '.') {
+      next();
+      if (c == '*') {
+        r.put32(va_arg(arg, int));
+        next();
+      }
+      while (c >= '0' && c <= '9') {
+        next();
+      }
+    }
+    int longs = 0;
+    for (; c == 'l' || c == 'h' || c == 'z'; next()) {
+      if (c == 'l') {
+        longs++;
+      }
+    }
+    switch (c) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+    case 'c':
+      if (longs >= 2) {
+        r.put64(va_arg(arg, long long));
+      } else if (longs == 1) {
+        r.put32(va_arg(arg, long));
+      } else {
+        r.put32(va_arg(arg, int));
+      }
+      break;
+    case 'f':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G': {
+      double d = va_arg(arg, double);
+      r.put(&d, sizeof(d));
+      break;
+    }
+    case 's':
+      r.put_str(va_arg(arg, const char *));
+      break;
+    case 'p':
+      r.put32(uint32_t(uintptr_t(va_arg(arg, void *))));
+      break;
+    default:
+      return;
+    }
   }
+}
 
+void log_(int lvl, const char *tag, const char *format, va_list a) {
+  BinaryRecord r;
+  r.put32(uint32_t(uintptr_t(format)));
+  r.put32(millis());
+  uint8_t l = lvl;
+  r.put(&l, 1);
+  r.put32(uint32_t(uintptr_t(tag)));
   va_list arg;
   va_copy(arg, a);
+  encode_args(r, format, arg);
+  va_end(arg);
+  size_t len = r.finish();
+
+  if (history_enabled) {
+    log_history.insert((const char *)r.buf, len);
+  }
+  log_store::append((const char *)r.buf, len);
+  Serial.write(r.buf, len);
+}
+#else
+char level_char(int lvl) {
+  static const char levels[] = "DIWE";
+  return lvl >= 0 && lvl < 4 ? levels[lvl] : '?';
+}
+
+void log_(int lvl, const char *tag, const char *format, va_list a) {
   char tmp[64];
   char *buffer = tmp;
-  size_t len = vsnprintf(buffer, sizeof(tmp), format, arg);
+  size_t prefix = 0;
+  if (tag) {
+    prefix = snprintf(tmp, sizeof(tmp), "%c %s: ", level_char(lvl), tag);
+  }
+
+  va_list arg;
+  va_copy(arg, a);
+  size_t len =
+      prefix + vsnprintf_P(buffer + prefix, sizeof(tmp) - prefix, format, arg);
   va_end(arg);
   if (len > sizeof(tmp) - 1) {
     buffer = new char[len + 1];
     if (!buffer) {
       return;
     }
+    memcpy(buffer, tmp, prefix);
     va_copy(arg, a);
-    vsnprintf(buffer, len + 1, format, arg);
+    vsnprintf_P(buffer + prefix, len + 1 - prefix, format, arg);
     va_end(arg);
   }
 
@@ -82,42 +308,53 @@ void log_(int lvl, const char *format, va_list a) {
     buffer[len] = 0;
   }
 
-  if (log_history) {
-    log_history->insert(buffer);
+  if (history_enabled) {
+    log_history.insert(buffer, len);
   }
-  
+  log_store::append(buffer, len);
+
   Serial.write((const uint8_t *)buffer, len);
   Serial.write("\n", 1);
   if (buffer != tmp) {
     delete[] buffer;
   }
 }
+#endif
 
 } // namespace
 
-void log(const char *format, ...) {
+void log_at(int lvl, const char *tag, const char *format, ...) {
+  if (lvl < runtime_level) {
+    return;
+  }
   va_list arg;
   va_start(arg, format);
-  log_(0, format, arg);
+  log_(lvl, tag, format, arg);
+  va_end(arg);
 }
 
-void xlog(const char *format, ...) {
+void log(const char *format, ...) {
+  if (S28_LOG_INFO < runtime_level) {
+    return;
+  }
   va_list arg;
   va_start(arg, format);
-  log_(1, format, arg);
+  log_(S28_LOG_INFO, nullptr, format, arg);
+  va_end(arg);
 }
 
+void set_log_level(int lvl) { runtime_level = lvl; }
+
+int log_level() { return runtime_level; }
+
 void flush_log_history(bool dont_write) {
   if (!history_enabled) {
     return;
   }
-  if (log_history) {
-    if (!dont_write) {
-      log_history->flush();
-    }
-    delete log_history;
+  if (!dont_write) {
+    log_history.flush();
   }
-  log_history = nullptr;
+  log_history.clear();
   history_enabled = false;
   Serial.printf("flush_log_history\n");
 }
@@ -1,9 +1,76 @@
 #ifndef s28_logging_h
 #define s28_logging_h
 
+#include <Arduino.h> // PSTR
+
+// Log levels. Calls below the module's S28_LOG_LEVEL_<MODULE> (by default
+// S28_LOG_LEVEL, either way) are removed at compile time together with their
+// format strings; set_log_level() filters the remaining ones at runtime.
+#define S28_LOG_DEBUG 0
+#define S28_LOG_INFO 1
+#define S28_LOG_WARN 2
+#define S28_LOG_ERROR 3
+#define S28_LOG_NONE 4
+
+#ifndef S28_LOG_LEVEL
+#define S28_LOG_LEVEL S28_LOG_INFO
+#endif
+
+#ifndef S28_LOG_LEVEL_MAIN
+#define S28_LOG_LEVEL_MAIN S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_ARGS
+#define S28_LOG_LEVEL_ARGS S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_UTILS
+#define S28_LOG_LEVEL_UTILS S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_PROBE
+#define S28_LOG_LEVEL_PROBE S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_CONFIG
+#define S28_LOG_LEVEL_CONFIG S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_WIFI
+#define S28_LOG_LEVEL_WIFI S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_TLS
+#define S28_LOG_LEVEL_TLS S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_SCHED
+#define S28_LOG_LEVEL_SCHED S28_LOG_LEVEL
+#endif
+#ifndef S28_LOG_LEVEL_S26
+#define S28_LOG_LEVEL_S26 S28_LOG_LEVEL
+#endif
+
+// Once per .cpp file, after the includes: S28_LOG_MODULE(ARGS, "args")
+#define S28_LOG_MODULE(module, tag)                                          \
+  namespace {                                                                \
+  constexpr int s28_log_module_level = S28_LOG_LEVEL_##module;               \
+  constexpr char s28_log_tag[] = tag;                                        \
+  }
+
+#define S28_LOG_AT(lvl, format, ...)                                         \
+  do {                                                                       \
+    if ((lvl) >= s28_log_module_level) {                                     \
+      ::s28::log_at((lvl), s28_log_tag, PSTR(format), ##__VA_ARGS__);        \
+    }                                                                        \
+  } while (0)
+
+#define LOGD(format, ...) S28_LOG_AT(S28_LOG_DEBUG, format, ##__VA_ARGS__)
+#define LOGI(format, ...) S28_LOG_AT(S28_LOG_INFO, format, ##__VA_ARGS__)
+#define LOGW(format, ...) S28_LOG_AT(S28_LOG_WARN, format, ##__VA_ARGS__)
+#define LOGE(format, ...) S28_LOG_AT(S28_LOG_ERROR, format, ##__VA_ARGS__)
+
 namespace s28 {
-void log(const char *format, ...);
+// `format` is a PROGMEM string, use the LOGx macros
+void log_at(int lvl, const char *tag, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+void log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+void set_log_level(int lvl);
+int log_level();
 void flush_log_history(bool dont_write = false);
 } // namespace s28
 
-#endif
\ No newline at end of file
+#endif
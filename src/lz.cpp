@@ -0,0 +1,126 @@
+#include "lz.h"
+
+#include <string.h>
+
+namespace s28 {
+namespace lz {
+
+namespace {
+constexpr size_t HASH_SIZE = 256;
+constexpr int MAX_CHAIN = 16;
+
+inline uint8_t hash3(const uint8_t *p) {
+  return uint8_t((p[0] << 2) ^ (p[1] << 1) ^ p[2]);
+}
+} // namespace
+
+size_t compress(const uint8_t *in, size_t len, uint8_t *out, size_t cap) {
+  if (len > MAX_BLOCK) {
+    return 0;
+  }
+  // chains of earlier positions with the same 3-byte hash
+  static int16_t head[HASH_SIZE];
+  static int16_t prev[MAX_BLOCK];
+  memset(head, 0xff, sizeof(head));
+
+  size_t o = 0;
+  size_t flag_pos = 0;
+  int nitems = 8;
+
+  auto insert = [&](size_t pos) {
+    if (pos + MIN_MATCH > len) {
+      return;
+    }
+    uint8_t h = hash3(in + pos);
+    prev[pos] = head[h];
+    head[h] = pos;
+  };
+
+  for (size_t i = 0; i < len;) {
+    if (nitems == 8) {
+      if (o == cap) {
+        return 0;
+      }
+      flag_pos = o;
+      out[o++] = 0;
+      nitems = 0;
+    }
+
+    size_t best_len = 0;
+    size_t best_off = 0;
+    if (i + MIN_MATCH <= len) {
+      size_t max = len - i < MAX_MATCH ? len - i : MAX_MATCH;
+      int chain = MAX_CHAIN;
+      for (int16_t c = head[hash3(in + i)]; c >= 0 && chain--; c = prev[c]) {
+        size_t n = 0;
+        while (n < max && in[c + n] == in[i + n]) {
+          ++n;
+        }
+        if (n > best_len) {
+          best_len = n;
+          best_off = i - c;
+          if (n == max) {
+            break;
+          }
+        }
+      }
+    }
+
+    if (best_len >= MIN_MATCH) {
+      if (o + 2 > cap) {
+        return 0;
+      }
+      uint16_t v = uint16_t(((best_off - 1) << 4) | (best_len - MIN_MATCH));
+      out[o++] = v & 0xff;
+      out[o++] = v >> 8;
+      out[flag_pos] |= 1 << nitems;
+      for (size_t k = 0; k < best_len; ++k) {
+        insert(i + k);
+      }
+      i += best_len;
+    } else {
+      if (o == cap) {
+        return 0;
+      }
+      out[o++] = in[i];
+      insert(i);
+      ++i;
+    }
+    ++nitems;
+  }
+  return o;
+}
+
+size_t decompress(const uint8_t *in, size_t len, uint8_t *out, size_t cap) {
+  size_t o = 0;
+  size_t i = 0;
+  while (i < len) {
+    uint8_t flags = in[i++];
+    for (int bit = 0; bit < 8 && i < len; ++bit) {
+      if (flags & (1 << bit)) {
+        if (i + 2 > len) {
+          return 0;
+        }
+        uint16_t v = in[i] | (in[i + 1] << 8);
+        i += 2;
+        size_t off = (v >> 4) + 1;
+        size_t n = (v & 0xf) + MIN_MATCH;
+        if (off > o || o + n > cap) {
+          return 0;
+        }
+        for (size_t k = 0; k < n; ++k, ++o) {
+          out[o] = out[o - off];
+        }
+      } else {
+        if (o == cap) {
+          return 0;
+        }
+        out[o++] = in[i++];
+      }
+    }
+  }
+  return o;
+}
+
+} // namespace lz
+} // namespace s28
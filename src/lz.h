@@ -0,0 +1,27 @@
+#ifndef s28_lz_h
+#define s28_lz_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace lz {
+
+// LZSS for small blocks (up to MAX_BLOCK bytes). Groups of 8 items are led
+// by a flag byte (bit set = match); a literal is one byte, a match two:
+//   offset - 1 (12 bits) | length - MIN_MATCH (4 bits), little endian.
+// tools/log_store.py has the matching decoder.
+constexpr size_t MAX_BLOCK = 512;
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = MIN_MATCH + 15;
+
+// Returns the compressed size, or 0 if the output would not fit `cap`.
+size_t compress(const uint8_t *in, size_t len, uint8_t *out, size_t cap);
+
+// Returns the decompressed size, or 0 on malformed input.
+size_t decompress(const uint8_t *in, size_t len, uint8_t *out, size_t cap);
+
+} // namespace lz
+} // namespace s28
+
+#endif
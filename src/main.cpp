@@ -17,11 +17,23 @@
 #include <vector>
 
 #include "app_iface.h"
+#include "alloc_stats.h"
 #include "apps/config/app.h"
 #include "apps/s26/app.h"
+#include "console.h"
+#include "log_store.h"
 #include "logging.h"
+#include "profiler.h"
+#include "scheduler.h"
 #include "utils.h"
 
+S28_LOG_MODULE(MAIN, "main")
+
+S28_PROFILE_SPAN(loop_span, "loop");
+S28_PROFILE_SPAN(app_span, "app.loop");
+S28_PROFILE_SPAN(sched_span, "sched.loop");
+S28_PROFILE_SPAN(log_span, "log.loop");
+
 
 using namespace s28;
 
@@ -31,42 +43,69 @@ StartupArgs startup_args;
 } // namespace
 
 void loop() {
-  app->loop();
+  S28_PROFILE_SCOPE(loop_span);
+  if (app) {
+    S28_PROFILE_SCOPE(app_span);
+    app->loop();
+  }
+  {
+    S28_PROFILE_SCOPE(sched_span);
+    scheduler::loop();
+  }
+  console::loop();
+  {
+    S28_PROFILE_SCOPE(log_span);
+    log_store::loop();
+  }
 }
 
 void setup() {
+  alloc_stats::phase("boot");
   Serial.begin(9600);
+  console::add("prof", "loop profile, \"prof reset\" clears",
+               profiler::command);
+  console::add("heap", "heap use per boot phase", alloc_stats::command);
 
   // disconnect AP by default
   WiFi.softAPdisconnect(true);
   
   delay(100);
-  log("starting...");
+  uint32_t boot = log_store::begin();
+  LOGI("starting... boot %u, reset reason: %s", unsigned(boot),
+       ESP.getResetReason().c_str());
+  alloc_stats::phase("log_store");
   read_startup_args(&startup_args);
+  alloc_stats::phase("args");
   pinMode(gpio_13_led, OUTPUT);
   pinMode(gpio_12_relay, OUTPUT);
   
   if (startup_args.is_entering_setup()) {
     // don't maintain history during the setup
     s28::flush_log_history(true);
-    log("entering setup...");
+    LOGI("entering setup...");
     startup_args.set_enter_setup(false);
     write_startup_args(&startup_args);
     digitalWrite(s28::gpio_13_led, LOW);
     app = s28::app_config::create(startup_args);
   } else {
-    log("entering sonoff-s26 app...");
+    LOGI("entering sonoff-s26 app...");
     digitalWrite(s28::gpio_13_led, HIGH);
     app = s28::s26::create(startup_args);
   }
+  alloc_stats::phase("app");
 
   if (app) {
     if (!app->setup()) {
-      log("setup failed");
+      LOGE("setup failed");
       delete app;
       app = nullptr;
     }
   } else {
-    log("no app initialized");
+    LOGE("no app initialized");
   }
+  alloc_stats::phase("app.setup");
+
+  utils::FsStats fs = utils::fs_stats();
+  LOGI("LittleFS: %u mount(s) for %u opens, %u us mounting",
+       unsigned(fs.mounts), unsigned(fs.opens), unsigned(fs.mount_us));
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "metrics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace s28 {
+namespace metrics {
+
+namespace {
+
+struct Writer {
+  char *buf;
+  size_t cap;
+  size_t len;
+  bool overflow;
+
+  void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    if (overflow) {
+      return;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + len, cap - len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || size_t(n) >= cap - len) {
+      overflow = true;
+      return;
+    }
+    len += n;
+  }
+
+  void metric(const char *name, const char *type, const char *help,
+              uint32_t value) {
+    printf("# HELP s28_%s %s\n# TYPE s28_%s %s\ns28_%s %u\n", name, help, name,
+           type, name, unsigned(value));
+  }
+
+  // one family, labelled by handshake type
+  void handshakes(const char *name, const char *type, const char *help,
+                  const Sample &s, uint32_t Handshakes::*field) {
+    printf("# HELP s28_%s %s\n# TYPE s28_%s %s\n"
+           "s28_%s{type=\"full\"} %u\ns28_%s{type=\"resumed\"} %u\n",
+           name, help, name, type, name, unsigned(s.tls_full.*field), name,
+           unsigned(s.tls_resumed.*field));
+  }
+};
+
+} // namespace
+
+size_t render_family(const Sample &s, size_t i, char *buf, size_t cap) {
+  Writer w{buf, cap, 0, cap == 0};
+  switch (i) {
+  case 0:
+    w.metric("uptime_seconds", "counter", "Seconds since boot.", s.uptime_s);
+    break;
+  case 1:
+    w.metric("heap_free_bytes", "gauge", "Free heap.", s.free_heap);
+    break;
+  case 2:
+    w.metric("heap_max_block_bytes", "gauge", "Largest free heap block.",
+             s.max_free_block);
+    break;
+  case 3:
+    w.metric("heap_fragmentation_percent", "gauge", "Heap fragmentation.",
+             s.fragmentation);
+    break;
+  case 4:
+    w.metric("loop_iterations_total", "counter", "Main loop iterations.",
+             s.loops);
+    break;
+  case 5:
+    w.metric("loop_max_us", "gauge",
+             "Longest main loop iteration in the last 1-2 minutes.",
+             s.loop_max_us);
+    break;
+  case 6:
+    w.printf("# HELP s28_wifi_rssi_dbm WiFi signal, 0 when not connected.\n"
+             "# TYPE s28_wifi_rssi_dbm gauge\ns28_wifi_rssi_dbm %d\n",
+             int(s.rssi));
+    break;
+  case 7:
+    w.metric("blynk_connects_total", "counter",
+             "Blynk connections, the first one included.", s.blynk_connects);
+    break;
+  case 8:
+    w.metric("relay_toggles_total", "counter", "Relay state changes.",
+             s.relay_toggles);
+    break;
+  case 9:
+    w.handshakes("tls_handshakes_total", "counter", "Blynk TLS handshakes.",
+                 s, &Handshakes::count);
+    break;
+  case 10:
+    w.handshakes("tls_handshake_ms_total", "counter",
+                 "Time spent connecting and in handshakes.", s,
+                 &Handshakes::total_ms);
+    break;
+  case 11:
+    w.handshakes("tls_handshake_max_ms", "gauge", "Slowest handshake.", s,
+                 &Handshakes::max_ms);
+    break;
+  case 12:
+    w.handshakes("tls_handshake_last_ms", "gauge", "Last handshake.", s,
+                 &Handshakes::last_ms);
+    break;
+  default:
+    return 0;
+  }
+  return w.overflow ? 0 : w.len;
+}
+
+void LoopMeter::tick(uint32_t now_us) {
+  if (loops++) {
+    uint32_t d = now_us - last_us;
+    if (d > cur_max) {
+      cur_max = d;
+    }
+  } else {
+    window_start_us = now_us;
+  }
+  last_us = now_us;
+  if (now_us - window_start_us >= WINDOW_MS * 1000) {
+    prev_max = cur_max;
+    cur_max = 0;
+    window_start_us = now_us;
+  }
+}
+
+} // namespace metrics
+} // namespace s28
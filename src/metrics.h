@@ -0,0 +1,61 @@
+#ifndef s28_metrics_h
+#define s28_metrics_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace metrics {
+
+// Prometheus text exposition of the running app, rendered one metric family
+// (HELP, TYPE and its samples) at a time into a caller buffer (no heap).
+// The values are gathered by the app, see Sample.
+
+struct Handshakes {
+  uint32_t count;
+  uint32_t total_ms;
+  uint32_t max_ms;
+  uint32_t last_ms;
+};
+
+struct Sample {
+  uint32_t uptime_s;
+  uint32_t free_heap;
+  uint32_t max_free_block;
+  uint32_t fragmentation; // percent
+  uint32_t loops;         // iterations since boot
+  uint32_t loop_max_us;   // longest iteration, last 1-2 minutes
+  int32_t rssi;           // dBm, 0 when not connected
+  uint32_t blynk_connects;
+  uint32_t relay_toggles;
+  Handshakes tls_full;
+  Handshakes tls_resumed;
+};
+
+constexpr size_t FAMILY_COUNT = 13;
+
+// every family fits into this with any values, the bench checks it
+constexpr size_t MAX_FAMILY_LEN = 256;
+
+// Renders family `i` < FAMILY_COUNT. Returns the length, or 0 when it does
+// not fit into `cap`.
+size_t render_family(const Sample &s, size_t i, char *buf, size_t cap);
+
+// Main loop timing, call once per iteration.
+struct LoopMeter {
+  static constexpr uint32_t WINDOW_MS = 60000;
+
+  void tick(uint32_t now_us);
+  uint32_t max_us() const { return prev_max > cur_max ? prev_max : cur_max; }
+
+  uint32_t loops = 0;
+  uint32_t last_us = 0;
+  uint32_t window_start_us = 0;
+  uint32_t cur_max = 0;
+  uint32_t prev_max = 0;
+};
+
+} // namespace metrics
+} // namespace s28
+
+#endif
@@ -0,0 +1,121 @@
+#include "probe_engine.h"
+
+#include <string.h>
+
+namespace s28 {
+namespace probe {
+
+namespace {
+
+using X509 = Engine::X509;
+
+void x509_start_chain(const br_x509_class **ctx, const char *server_name) {
+  X509 *xc = (X509 *)ctx;
+  br_sha1_init(&xc->sha1_cert);
+}
+
+void x509_start_cert(const br_x509_class **ctx, uint32_t length) {}
+
+void x509_append(const br_x509_class **ctx, const unsigned char *buf,
+                 size_t len) {
+  X509 *xc = (X509 *)ctx;
+  if (xc->done_cert)
+    return;
+  br_sha1_update(&xc->sha1_cert, buf, len);
+  xc->ok = true;
+}
+
+void x509_end_cert(const br_x509_class **ctx) {
+  X509 *xc = (X509 *)ctx;
+  if (xc->done_cert)
+    return;
+  xc->done_cert = true;
+  br_sha1_out(&xc->sha1_cert, xc->fingerprint);
+}
+
+// rejecting the chain ends the handshake right after the certificate
+unsigned x509_end_chain(const br_x509_class **ctx) {
+  return BR_ERR_X509_NOT_TRUSTED;
+}
+
+const br_x509_pkey *x509_get_pkey(const br_x509_class *const *ctx,
+                                  unsigned *usages) {
+  return 0;
+}
+
+const br_x509_class x509_vtable = {
+    sizeof(X509),   x509_start_chain, x509_start_cert, x509_append,
+    x509_end_cert,  x509_end_chain,   x509_get_pkey};
+
+} // namespace
+
+void Engine::start(const char *server_name, uint8_t *fingerprint,
+                   uint32_t now_ms, uint32_t timeout_ms,
+                   tls_profile::Profile profile) {
+  tls_profile::init_client(&sc, profile);
+
+  memset(&xc, 0, sizeof(xc));
+  xc.vtable = &x509_vtable;
+  xc.fingerprint = fingerprint;
+  br_ssl_engine_set_x509(&sc.eng, &xc.vtable);
+
+  br_ssl_engine_set_buffer(&sc.eng, iobuf, IOBUF_LEN, 0);
+  br_ssl_client_reset(&sc, server_name, 0);
+  deadline = now_ms + timeout_ms;
+  bytes_in = 0;
+  bytes_out = 0;
+  status = PENDING;
+}
+
+Status Engine::step(Transport &t, uint32_t now_ms) {
+  br_ssl_engine_context *eng = &sc.eng;
+
+  while (status == PENDING) {
+    unsigned st = br_ssl_engine_current_state(eng);
+
+    if (st & BR_SSL_CLOSED) {
+      // the chain is rejected on purpose once the cert is hashed
+      status = br_ssl_engine_last_error(eng) == BR_ERR_X509_NOT_TRUSTED &&
+                       xc.done_cert && xc.ok
+                   ? OK
+                   : FAILED;
+      break;
+    }
+
+    int n = 0;
+    if (st & BR_SSL_SENDREC) {
+      size_t len;
+      unsigned char *buf = br_ssl_engine_sendrec_buf(eng, &len);
+      n = t.write(buf, len);
+      if (n > 0) {
+        br_ssl_engine_sendrec_ack(eng, n);
+        bytes_out += n;
+      }
+    } else if (st & BR_SSL_RECVREC) {
+      size_t len;
+      unsigned char *buf = br_ssl_engine_recvrec_buf(eng, &len);
+      n = t.read(buf, len);
+      if (n > 0) {
+        br_ssl_engine_recvrec_ack(eng, n);
+        bytes_in += n;
+      }
+    } else if (st & BR_SSL_SENDAPP) {
+      // cannot happen while end_chain() rejects everything
+      br_ssl_engine_close(eng);
+      continue;
+    }
+
+    if (n < 0) {
+      status = FAILED;
+    } else if (n == 0) {
+      if (int32_t(now_ms - deadline) >= 0) {
+        status = TIMEOUT;
+      }
+      break; // would block
+    }
+  }
+  return status;
+}
+
+} // namespace probe
+} // namespace s28
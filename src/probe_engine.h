@@ -0,0 +1,70 @@
+#ifndef s28_probe_engine_h
+#define s28_probe_engine_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tls_profile.h"
+
+namespace s28 {
+namespace probe {
+
+// Non-blocking byte pipe under the engine.
+struct Transport {
+  virtual ~Transport() {}
+  // Bytes moved, 0 when the call would block, -1 when the connection is
+  // gone.
+  virtual int read(unsigned char *buf, size_t len) = 0;
+  virtual int write(const unsigned char *buf, size_t len) = 0;
+};
+
+enum Status { PENDING, OK, FAILED, TIMEOUT };
+
+// Runs a TLS client handshake just far enough to hash the server
+// certificate (SHA-1 of the first certificate in the chain) and then
+// aborts it. Nothing platform specific: the firmware drives it over a
+// WiFiClient, the host tools in tools/tls over a socket.
+struct Engine {
+  // 512 byte records (max_fragment_length) plus the record overhead
+  static const size_t IOBUF_LEN = 837;
+
+  // `fingerprint` receives 20 bytes once step() returns OK.
+  void start(const char *server_name, uint8_t *fingerprint, uint32_t now_ms,
+             uint32_t timeout_ms,
+             tls_profile::Profile profile = tls_profile::DEFAULT);
+
+  // Moves whatever the transport can take or give right now, in whole
+  // buffers, and returns without waiting.
+  Status step(Transport &t, uint32_t now_ms);
+
+  // the engine has a record to send, wait for the socket to be writable
+  bool wants_write() const {
+    return br_ssl_engine_current_state(&sc.eng) & BR_SSL_SENDREC;
+  }
+
+  // BearSSL error code of a failed probe
+  int last_error() const { return br_ssl_engine_last_error(&sc.eng); }
+
+  uint32_t bytes_in = 0;
+  uint32_t bytes_out = 0;
+
+  struct X509 {
+    const br_x509_class *vtable;
+    br_sha1_context sha1_cert;
+    bool done_cert;
+    bool ok;
+    uint8_t *fingerprint;
+  };
+
+private:
+  br_ssl_client_context sc;
+  X509 xc;
+  unsigned char iobuf[IOBUF_LEN];
+  uint32_t deadline = 0;
+  Status status = PENDING;
+};
+
+} // namespace probe
+} // namespace s28
+
+#endif
@@ -0,0 +1,91 @@
+#include "profiler.h"
+
+#include <string.h>
+
+namespace s28 {
+namespace profiler {
+
+#ifdef S28_PROFILE
+
+namespace {
+
+// spans are statics, the list head is zero initialized before any of them
+Span *spans = nullptr;
+
+// tenths of a microsecond
+uint32_t to_us10(uint64_t cycles) {
+  return uint32_t(cycles * 10 / ESP.getCpuFreqMHz());
+}
+
+} // namespace
+
+Span::Span(const char *name) : name(name), next(spans) {
+  reset();
+  spans = this;
+}
+
+void Span::add(uint32_t cycles) {
+  count++;
+  sum_cycles += cycles;
+  if (cycles < min_cycles) {
+    min_cycles = cycles;
+  }
+  if (cycles > max_cycles) {
+    max_cycles = cycles;
+  }
+  us.add(cycles / ESP.getCpuFreqMHz());
+}
+
+void Span::reset() {
+  count = 0;
+  min_cycles = UINT32_MAX;
+  max_cycles = 0;
+  sum_cycles = 0;
+  us.reset();
+}
+
+void dump(Print &out) {
+  out.printf("%-12s %8s %10s %10s %10s %8s %8s\n", "span", "count", "min_us",
+             "mean_us", "max_us", "p50_us", "p99_us");
+  for (Span *s = spans; s; s = s->next) {
+    if (!s->count) {
+      out.printf("%-12s %8u\n", s->name, 0u);
+      continue;
+    }
+    uint32_t min = to_us10(s->min_cycles);
+    uint32_t mean = to_us10(s->sum_cycles / s->count);
+    uint32_t max = to_us10(s->max_cycles);
+    out.printf("%-12s %8u %8u.%u %8u.%u %8u.%u %8u %8u\n", s->name,
+               unsigned(s->count), unsigned(min / 10), unsigned(min % 10),
+               unsigned(mean / 10), unsigned(mean % 10), unsigned(max / 10),
+               unsigned(max % 10), unsigned(s->us.percentile(500)),
+               unsigned(s->us.percentile(990)));
+  }
+}
+
+void reset() {
+  for (Span *s = spans; s; s = s->next) {
+    s->reset();
+  }
+}
+
+#else
+
+void dump(Print &out) {
+  out.printf("profiling disabled, build with -DS28_PROFILE\n");
+}
+
+void reset() {}
+
+#endif
+
+void command(const char *args) {
+  if (strcmp(args, "reset") == 0) {
+    reset();
+    return;
+  }
+  dump(Serial);
+}
+
+} // namespace profiler
+} // namespace s28
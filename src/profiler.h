@@ -0,0 +1,69 @@
+#ifndef s28_profiler_h
+#define s28_profiler_h
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "histogram.h"
+
+// Scoped timing spans on the CPU cycle counter, built with -DS28_PROFILE:
+//
+//   S28_PROFILE_SPAN(http_span, "http");     // namespace scope
+//   ...
+//   { S28_PROFILE_SCOPE(http_span); server->handleClient(); }
+//
+// Without S28_PROFILE both macros expand to nothing.
+
+namespace s28 {
+namespace profiler {
+
+#ifdef S28_PROFILE
+
+struct Span {
+  explicit Span(const char *name); // registers the span for dump()
+
+  void add(uint32_t cycles);
+  void reset();
+
+  const char *name;
+  uint32_t count;
+  uint32_t min_cycles;
+  uint32_t max_cycles;
+  uint64_t sum_cycles;
+  Histogram us;
+  Span *next;
+};
+
+struct Scope {
+  explicit Scope(Span &span) : span(span), start(ESP.getCycleCount()) {}
+  ~Scope() { span.add(ESP.getCycleCount() - start); }
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+  Span &span;
+  uint32_t start;
+};
+
+#define S28_PROFILE_SPAN(var, name) static s28::profiler::Span var(name)
+#define S28_PROFILE_SCOPE(var) s28::profiler::Scope var##_scope(var)
+
+#else
+
+#define S28_PROFILE_SPAN(var, name) static_assert(true, "")
+#define S28_PROFILE_SCOPE(var)                                                 \
+  do {                                                                         \
+  } while (0)
+
+#endif
+
+// One line per span: count, min/mean/max and p50/p99 in microseconds.
+void dump(Print &out);
+void reset();
+
+// console command: "prof" dumps, "prof reset" clears
+void command(const char *args);
+
+} // namespace profiler
+} // namespace s28
+
+#endif
@@ -0,0 +1,67 @@
+#include "relay_latency.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+
+namespace s28 {
+namespace relay_latency {
+
+namespace {
+
+uint32_t run_cycles;
+uint32_t handler_cycles;
+bool in_run = false;
+
+Stage run_to_handler;
+Stage handler_to_relay;
+Histogram total;
+
+uint32_t to_us(uint32_t cycles) { return cycles / ESP.getCpuFreqMHz(); }
+
+void account(Stage *s, uint32_t us) {
+  s->last_us = us;
+  if (us > s->max_us) {
+    s->max_us = us;
+  }
+}
+
+} // namespace
+
+void run_entered() {
+  run_cycles = ESP.getCycleCount();
+  in_run = true;
+}
+
+void run_left() { in_run = false; }
+
+void handler_entered() {
+  handler_cycles = ESP.getCycleCount();
+  if (!in_run) {
+    run_cycles = handler_cycles;
+  }
+}
+
+void relay_written() {
+  uint32_t now = ESP.getCycleCount();
+  account(&run_to_handler, to_us(handler_cycles - run_cycles));
+  account(&handler_to_relay, to_us(now - handler_cycles));
+  total.add(to_us(now - run_cycles));
+}
+
+Stats stats() { return {run_to_handler, handler_to_relay, total}; }
+
+void reset() {
+  run_to_handler = Stage();
+  handler_to_relay = Stage();
+  total.reset();
+}
+
+size_t format(char *buf, size_t cap) {
+  int n = snprintf(buf, cap, "n=%u p50=%uus p99=%uus max=%uus",
+                   unsigned(total.count), unsigned(total.percentile(500)),
+                   unsigned(total.percentile(990)), unsigned(total.max));
+  return n < 0 ? 0 : size_t(n) < cap ? n : cap - 1;
+}
+
+} // namespace relay_latency
+} // namespace s28
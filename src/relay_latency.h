@@ -0,0 +1,45 @@
+#ifndef s28_relay_latency_h
+#define s28_relay_latency_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "histogram.h"
+
+namespace s28 {
+namespace relay_latency {
+
+// Time from a Blynk V1 write reaching the firmware to the relay GPIO
+// changing, stamped with the CPU cycle counter:
+//   run     Blynk.run() entered (the frame is read, decrypted and parsed
+//           in this call)
+//   handler BLYNK_WRITE(V1) entered
+//   relay   digitalWrite(gpio_12_relay) returned
+// A handler not called from run() (e.g. syncVirtual) starts at its entry.
+
+void run_entered();
+void run_left();
+void handler_entered();
+void relay_written();
+
+struct Stage {
+  uint32_t last_us;
+  uint32_t max_us;
+};
+
+struct Stats {
+  Stage run_to_handler;
+  Stage handler_to_relay;
+  const Histogram &total; // run to relay, us
+};
+
+Stats stats();
+void reset();
+
+// "n=12 p50=840us p99=2100us max=2300us"
+size_t format(char *buf, size_t cap);
+
+} // namespace relay_latency
+} // namespace s28
+
+#endif
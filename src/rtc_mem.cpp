@@ -0,0 +1,94 @@
+#include "rtc_mem.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "utils.h"
+
+extern "C" {
+#include <user_interface.h>
+}
+
+namespace s28 {
+namespace rtc_mem {
+
+namespace {
+
+constexpr uint16_t REGION_MAGIC = 0x5352; // "RS"
+
+struct Header {
+  uint16_t magic;
+  uint16_t len;
+  uint32_t crc; // of the header (crc = 0) and the payload
+};
+
+struct Layout {
+  uint32_t offset; // in 4-byte blocks
+  uint32_t size;   // bytes, header included
+};
+
+// 96 blocks are ours, from block 32 to the end of the user memory
+const Layout layout[REGION_COUNT] = {
+    {32, 248}, // CONFIG: the binary StartupArgs record
+    {94, 40},  // WIFI: wifi_cache::Lease
+    {104, 96}, // TLS: tls_session, the BearSSL session parameters
+};
+
+uint32_t region_crc(Header h, const uint8_t *payload) {
+  h.crc = 0;
+  return utils::crc32(payload, h.len, utils::crc32(&h, sizeof(h)));
+}
+
+} // namespace
+
+size_t capacity(Region r) { return layout[r].size - sizeof(Header); }
+
+bool warm_boot() {
+  const rst_info *info = ESP.getResetInfoPtr();
+  return info->reason != REASON_DEFAULT_RST &&
+         info->reason != REASON_EXT_SYS_RST;
+}
+
+size_t read(Region r, void *data, size_t cap) {
+  if (!warm_boot()) {
+    return 0;
+  }
+  uint32_t buf[64];
+  const Layout &l = layout[r];
+  if (!ESP.rtcUserMemoryRead(l.offset, buf, l.size)) {
+    return 0;
+  }
+  Header h;
+  memcpy(&h, buf, sizeof(h));
+  const uint8_t *payload = (const uint8_t *)buf + sizeof(h);
+  if (h.magic != REGION_MAGIC || h.len > capacity(r) || h.len > cap ||
+      region_crc(h, payload) != h.crc) {
+    return 0;
+  }
+  memcpy(data, payload, h.len);
+  return h.len;
+}
+
+bool write(Region r, const void *data, size_t len) {
+  if (len > capacity(r)) {
+    invalidate(r);
+    return false;
+  }
+  uint32_t buf[64];
+  const Layout &l = layout[r];
+  Header h = {REGION_MAGIC, uint16_t(len), 0};
+  memcpy((uint8_t *)buf + sizeof(h), data, len);
+  h.crc = region_crc(h, (const uint8_t *)buf + sizeof(h));
+  memcpy(buf, &h, sizeof(h));
+  // whole blocks only
+  size_t size = (sizeof(h) + len + 3) & ~size_t(3);
+  return ESP.rtcUserMemoryWrite(l.offset, buf, size);
+}
+
+void invalidate(Region r) {
+  uint32_t zero = 0;
+  ESP.rtcUserMemoryWrite(layout[r].offset, &zero, sizeof(zero));
+}
+
+} // namespace rtc_mem
+} // namespace s28
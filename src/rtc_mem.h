@@ -0,0 +1,29 @@
+#ifndef s28_rtc_mem_h
+#define s28_rtc_mem_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace rtc_mem {
+
+// CRC protected regions in the RTC user memory, which survives soft and
+// watchdog resets but not a power cycle. The first 128 bytes are left to
+// the core (OTA command block).
+enum Region { CONFIG, WIFI, TLS, REGION_COUNT };
+
+// largest payload of a region
+size_t capacity(Region r);
+
+// true only after a reset that keeps the RTC memory
+bool warm_boot();
+
+// Returns the payload length, 0 if the region holds no valid data.
+size_t read(Region r, void *data, size_t cap);
+bool write(Region r, const void *data, size_t len);
+void invalidate(Region r);
+
+} // namespace rtc_mem
+} // namespace s28
+
+#endif
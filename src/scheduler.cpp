@@ -0,0 +1,135 @@
+#include "scheduler.h"
+
+#include <Arduino.h>
+
+#include "logging.h"
+
+S28_LOG_MODULE(SCHED, "sched")
+
+namespace s28 {
+namespace scheduler {
+
+struct Access {
+  static Task *head;
+  static Task *cursor; // where the next loop() starts
+  static size_t count;
+
+  static void link(Task *task) {
+    if (task->linked) {
+      return;
+    }
+    task->next = head;
+    task->linked = true;
+    head = task;
+    ++count;
+  }
+
+  static void unlink(Task *task) {
+    if (!task->linked) {
+      return;
+    }
+    for (Task **p = &head; *p; p = &(*p)->next) {
+      if (*p == task) {
+        *p = task->next;
+        break;
+      }
+    }
+    if (cursor == task) {
+      cursor = task->next;
+    }
+    task->linked = false;
+    --count;
+  }
+
+  static void run(Task *task) {
+    uint32_t late = millis() - task->due;
+    if (late > task->max_latency_ms) {
+      task->max_latency_ms = late;
+    }
+
+    uint32_t start = micros();
+    uint32_t delay_ms = task->run();
+    uint32_t us = micros() - start;
+
+    task->runs++;
+    task->run_us += us;
+    if (us > task->max_run_us) {
+      task->max_run_us = us;
+    }
+    if (delay_ms == Task::DONE) {
+      task->active = false;
+    } else {
+      task->due = millis() + delay_ms;
+    }
+  }
+
+  static bool due(const Task *task) {
+    return task->active && int32_t(millis() - task->due) >= 0;
+  }
+
+  static bool active(const Task *task) { return task->active; }
+
+  static void schedule(Task *task, uint32_t delay_ms) {
+    link(task);
+    task->active = true;
+    task->due = millis() + delay_ms;
+  }
+
+  static void stop(Task *task) { task->active = false; }
+
+  static Task *next(const Task *task) { return task->next; }
+};
+
+Task *Access::head = nullptr;
+Task *Access::cursor = nullptr;
+size_t Access::count = 0;
+
+Task::~Task() { Access::unlink(this); }
+
+void add(Task *task, uint32_t delay_ms) { Access::schedule(task, delay_ms); }
+
+void cancel(Task *task) { Access::stop(task); }
+
+bool active(const Task *task) { return Access::active(task); }
+
+size_t loop(uint32_t budget_us) {
+  uint32_t start = micros();
+  size_t runs = 0;
+  Task *task = Access::cursor ? Access::cursor : Access::head;
+  // a task may add others while running, they are picked up next time
+  for (size_t i = Access::count; i && task; --i) {
+    Task *next = Access::next(task);
+    if (!next) {
+      next = Access::head;
+    }
+    if (Access::due(task)) {
+      Access::run(task);
+      ++runs;
+      if (micros() - start >= budget_us) {
+        task = next;
+        break;
+      }
+    }
+    task = next;
+  }
+  Access::cursor = task;
+  return runs;
+}
+
+void for_each(const std::function<void(const Task &)> &fn) {
+  for (Task *task = Access::head; task; task = Access::next(task)) {
+    fn(*task);
+  }
+}
+
+void dump() {
+  for_each([](const Task &task) {
+    LOGI("task %s: %s, %u runs, avg %u us, max %u us, max latency %u ms",
+         task.name, active(&task) ? "active" : "idle", unsigned(task.runs),
+         unsigned(task.runs ? task.run_us / task.runs : 0),
+         unsigned(task.max_run_us), unsigned(task.max_latency_ms));
+  });
+}
+
+} // namespace scheduler
+} // namespace s28
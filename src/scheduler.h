@@ -0,0 +1,77 @@
+#ifndef s28_scheduler_h
+#define s28_scheduler_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+namespace s28 {
+namespace scheduler {
+
+// Cooperative tasks run from the main loop. A task does a short, bounded
+// piece of work per run() and returns how long to sleep before the next
+// one, so a flow that used to block in delay() becomes a small state
+// machine and the loop keeps serving everything else. Nothing preempts a
+// step: one that blocks (a socket connect, a flash write) delays the loop.
+struct Task {
+  static constexpr uint32_t DONE = 0xffffffff;
+
+  explicit Task(const char *name) : name(name) {}
+  virtual ~Task();
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  // returns the delay in ms until the next run, or DONE
+  virtual uint32_t run() = 0;
+
+  const char *name;
+
+  // statistics, kept across add() calls
+  uint32_t runs = 0;
+  uint32_t run_us = 0; // total time spent in run()
+  uint32_t max_run_us = 0;
+  uint32_t max_latency_ms = 0; // how late a run started after it was due
+
+private:
+  friend struct Access;
+  Task *next = nullptr;
+  uint32_t due = 0;
+  bool linked = false;
+  bool active = false;
+};
+
+// A task calling a function object, typically a lambda bound to an app.
+struct FnTask : public Task {
+  FnTask(const char *name, std::function<uint32_t()> fn)
+      : Task(name), fn(fn) {}
+  uint32_t run() override { return fn(); }
+  std::function<uint32_t()> fn;
+};
+
+// the scheduler stops starting tasks once a loop took this long
+constexpr uint32_t LOOP_BUDGET_US = 10000;
+
+// Schedules the task to run after `delay_ms`; the task must outlive its
+// registration (the destructor unregisters it).
+void add(Task *task, uint32_t delay_ms = 0);
+
+// stops the task, its statistics stay available
+void cancel(Task *task);
+
+bool active(const Task *task);
+
+// Runs the tasks that are due, round robin, until the budget is spent.
+// Returns the number of runs.
+size_t loop(uint32_t budget_us = LOOP_BUDGET_US);
+
+// calls fn for every task ever added and not destroyed yet
+void for_each(const std::function<void(const Task &)> &fn);
+
+// logs the per-task statistics
+void dump();
+
+} // namespace scheduler
+} // namespace s28
+
+#endif
@@ -0,0 +1,40 @@
+#include "sink.h"
+
+#include <string.h>
+
+namespace s28 {
+
+size_t BoundedPrint::write(const uint8_t *data, size_t n) {
+  size_t room = cap - 1 - len;
+  if (n > room) {
+    n = room;
+    overflowed = true;
+  }
+  memcpy(buf + len, data, n);
+  len += n;
+  buf[len] = 0;
+  return n;
+}
+
+size_t ChunkPrint::write(const uint8_t *data, size_t n) {
+  if (len + n > cap) {
+    flush();
+    if (n >= cap) {
+      // large pieces go out as they are
+      send((const char *)data, n);
+      return n;
+    }
+  }
+  memcpy(buf + len, data, n);
+  len += n;
+  return n;
+}
+
+void ChunkPrint::flush() {
+  if (len) {
+    send(buf, len);
+    len = 0;
+  }
+}
+
+} // namespace s28
@@ -0,0 +1,57 @@
+#ifndef s28_sink_h
+#define s28_sink_h
+
+#include <Arduino.h>
+#include <assert.h>
+#include <stddef.h>
+
+namespace s28 {
+
+// Output sinks for generators that print their result piecewise (html
+// form, network list, json) instead of building a String.
+
+// Writes into a fixed array, always terminated; what does not fit is
+// dropped and remembered.
+struct BoundedPrint : public Print {
+  BoundedPrint(char *buf, size_t cap) : buf(buf), cap(cap) {
+    assert(cap > 0);
+    buf[0] = 0;
+  }
+
+  using Print::write;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t n) override;
+
+  const char *c_str() const { return buf; }
+  size_t length() const { return len; }
+  bool overflow() const { return overflowed; }
+
+private:
+  char *buf;
+  size_t cap;
+  size_t len = 0;
+  bool overflowed = false;
+};
+
+// Collects small writes in a fixed buffer and passes them on in chunks of
+// up to `cap` bytes, e.g. to an HTTP response. Call flush() at the end.
+struct ChunkPrint : public Print {
+  ChunkPrint(char *buf, size_t cap) : buf(buf), cap(cap) {}
+
+  using Print::write;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t n) override;
+  void flush() override;
+
+protected:
+  virtual void send(const char *data, size_t n) = 0;
+
+private:
+  char *buf;
+  size_t cap;
+  size_t len = 0;
+};
+
+} // namespace s28
+
+#endif
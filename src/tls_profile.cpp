@@ -0,0 +1,73 @@
+#include "tls_profile.h"
+
+namespace s28 {
+namespace tls_profile {
+
+namespace {
+
+const uint16_t minimal_suites[] = {
+    BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+};
+
+const uint16_t compat_suites[] = {
+    BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384,
+    BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA,
+    BR_TLS_RSA_WITH_AES_128_GCM_SHA256,
+    BR_TLS_RSA_WITH_AES_128_CBC_SHA,
+};
+
+} // namespace
+
+const char *name(Profile p) { return p == MINIMAL ? "minimal" : "compat"; }
+
+const uint16_t *suites(Profile p, size_t *count) {
+  if (p == MINIMAL) {
+    *count = sizeof(minimal_suites) / sizeof(minimal_suites[0]);
+    return minimal_suites;
+  }
+  *count = sizeof(compat_suites) / sizeof(compat_suites[0]);
+  return compat_suites;
+}
+
+void init_client(br_ssl_client_context *cc, Profile p) {
+  br_ssl_engine_context *eng = &cc->eng;
+  size_t count;
+  const uint16_t *list = suites(p, &count);
+
+  br_ssl_client_zero(cc);
+  br_ssl_engine_set_suites(eng, list, count);
+  br_ssl_engine_set_hash(eng, br_sha256_ID, &br_sha256_vtable);
+  br_ssl_engine_set_prf_sha256(eng, &br_tls12_sha256_prf);
+  br_ssl_engine_set_default_chapol(eng);
+  br_ssl_engine_set_default_aes_gcm(eng);
+
+  if (p == MINIMAL) {
+    br_ssl_engine_set_versions(eng, BR_TLS12, BR_TLS12);
+    br_ssl_engine_set_ec(eng, &br_ec_p256_m15);
+    br_ssl_engine_set_ecdsa(eng, &br_ecdsa_i15_vrfy_asn1);
+    return;
+  }
+
+  br_ssl_engine_set_versions(eng, BR_TLS10, BR_TLS12);
+  br_ssl_engine_set_hash(eng, br_md5_ID, &br_md5_vtable);
+  br_ssl_engine_set_hash(eng, br_sha1_ID, &br_sha1_vtable);
+  br_ssl_engine_set_hash(eng, br_sha384_ID, &br_sha384_vtable);
+  br_ssl_engine_set_prf10(eng, &br_tls10_prf);
+  br_ssl_engine_set_prf_sha384(eng, &br_tls12_sha384_prf);
+  br_ssl_engine_set_default_aes_cbc(eng);
+  br_ssl_engine_set_default_ecdsa(eng);
+  br_ssl_engine_set_default_rsavrfy(eng);
+  br_ssl_client_set_default_rsapub(cc);
+}
+
+} // namespace tls_profile
+} // namespace s28
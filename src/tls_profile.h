@@ -0,0 +1,51 @@
+#ifndef s28_tls_profile_h
+#define s28_tls_profile_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef S28_NATIVE
+#include <bearssl.h>
+#else
+#include <bearssl/bearssl.h>
+#endif
+
+// Build with -DS28_TLS_PROFILE=0 when every collector has an ECDSA
+// certificate.
+#define S28_TLS_MINIMAL 0
+#define S28_TLS_COMPAT 1
+
+#ifndef S28_TLS_PROFILE
+#define S28_TLS_PROFILE S28_TLS_COMPAT
+#endif
+
+namespace s28 {
+namespace tls_profile {
+
+// What a TLS client offers. Fewer suites and hashes mean a shorter
+// ClientHello, fewer algorithms linked in and no expensive suite the
+// server could pick.
+enum Profile {
+  // TLS 1.2, ECDHE-ECDSA with ChaCha20-Poly1305 or AES-128-GCM, P-256,
+  // SHA-256 only
+  MINIMAL = S28_TLS_MINIMAL,
+  // TLS 1.0-1.2, ECDHE with ECDSA or RSA certificates, AEAD and CBC
+  // suites, plain RSA key exchange as the last resort; no 3DES
+  COMPAT = S28_TLS_COMPAT,
+};
+
+constexpr Profile DEFAULT = Profile(S28_TLS_PROFILE);
+
+const char *name(Profile p);
+
+const uint16_t *suites(Profile p, size_t *count);
+
+// Resets the client and installs the versions, suites and the algorithm
+// implementations the profile needs for a complete handshake. The X.509
+// engine is left to the caller.
+void init_client(br_ssl_client_context *cc, Profile p);
+
+} // namespace tls_profile
+} // namespace s28
+
+#endif
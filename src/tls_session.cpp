@@ -0,0 +1,86 @@
+#include "tls_session.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "logging.h"
+#include "rtc_mem.h"
+
+S28_LOG_MODULE(TLS, "tls")
+
+namespace s28 {
+namespace tls_session {
+
+namespace {
+
+// BearSSL::Session keeps its parameters private; it holds nothing else, so
+// it is copied as a whole.
+static_assert(sizeof(BearSSL::Session) == sizeof(br_ssl_session_parameters),
+              "BearSSL::Session layout changed");
+
+BearSSL::WiFiClientSecure *client = nullptr;
+BearSSL::Session session;
+br_ssl_session_parameters before; // the session offered by the pending connect
+Stats totals = {};
+
+br_ssl_session_parameters current() {
+  br_ssl_session_parameters p;
+  memcpy(&p, &session, sizeof(p));
+  return p;
+}
+
+void account(HandshakeStats *s, uint32_t ms) {
+  s->count++;
+  s->total_ms += ms;
+  s->last_ms = ms;
+  if (ms > s->max_ms) {
+    s->max_ms = ms;
+  }
+}
+
+} // namespace
+
+void begin(BearSSL::WiFiClientSecure *c) {
+  client = c;
+  br_ssl_session_parameters p;
+  if (rtc_mem::read(rtc_mem::TLS, &p, sizeof(p)) == sizeof(p)) {
+    memcpy(&session, &p, sizeof(p));
+    LOGD("session restored");
+  }
+  client->setSession(&session);
+}
+
+HandshakeWatch::HandshakeWatch()
+    : was_connected(!client || client->connected()), start(millis()) {
+  if (!was_connected) {
+    before = current();
+  }
+}
+
+HandshakeWatch::~HandshakeWatch() {
+  if (was_connected || !client->connected()) {
+    return;
+  }
+  uint32_t ms = millis() - start;
+  br_ssl_session_parameters now = current();
+  // the server resumes by echoing the offered session ID
+  bool resumed = before.session_id_len != 0 &&
+                 before.session_id_len == now.session_id_len &&
+                 memcmp(before.session_id, now.session_id,
+                        now.session_id_len) == 0;
+  if (resumed) {
+    account(&totals.resumed, ms);
+  } else {
+    account(&totals.full, ms);
+    if (!rtc_mem::write(rtc_mem::TLS, &now, sizeof(now))) {
+      LOGW("session does not fit the RTC memory");
+    }
+  }
+  LOGI("TLS connected in %u ms (%s)", unsigned(ms),
+       resumed ? "resumed" : "full handshake");
+}
+
+Stats stats() { return totals; }
+
+} // namespace tls_session
+} // namespace s28
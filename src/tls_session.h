@@ -0,0 +1,51 @@
+#ifndef s28_tls_session_h
+#define s28_tls_session_h
+
+#include <WiFiClientSecureBearSSL.h>
+#include <stdint.h>
+
+namespace s28 {
+namespace tls_session {
+
+// TLS session resumption for a long lived client (the Blynk connection).
+// The negotiated session is kept across reconnects and in RTC memory
+// across warm reboots, so a reconnect to the same server does the
+// abbreviated handshake instead of the ECDHE/RSA one. A server that does
+// not know the session simply answers with a full handshake.
+
+// Restores the session from RTC memory and attaches it to the client.
+void begin(BearSSL::WiFiClientSecure *client);
+
+// Put one on the stack around any call that may (re)connect the client,
+// e.g. Blynk.run(). A call that brought the connection up is accounted as
+// a full or a resumed handshake.
+struct HandshakeWatch {
+  HandshakeWatch();
+  ~HandshakeWatch();
+  HandshakeWatch(const HandshakeWatch &) = delete;
+  HandshakeWatch &operator=(const HandshakeWatch &) = delete;
+
+private:
+  bool was_connected;
+  uint32_t start;
+};
+
+// TCP connect plus handshake, measured around the connecting call
+struct HandshakeStats {
+  uint32_t count;
+  uint32_t total_ms;
+  uint32_t max_ms;
+  uint32_t last_ms;
+};
+
+struct Stats {
+  HandshakeStats full;
+  HandshakeStats resumed;
+};
+
+Stats stats();
+
+} // namespace tls_session
+} // namespace s28
+
+#endif
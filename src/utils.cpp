@@ -1,44 +1,169 @@
 #include "utils.h"
 #include "logging.h"
 #include <LittleFS.h>
+#include <stdint.h>
+
+S28_LOG_MODULE(UTILS, "utils")
 
 namespace s28 {
 namespace utils {
 
-String escape_html(const String &data) {
-  String res;
-
-  for (size_t pos = 0; pos != data.length(); ++pos) {
-    switch (data[pos]) {
-    case '&':
-      res += "&amp;";
-      break;
-    case '\"':
-      res += "&quot;";
-      break;
-    case '\'':
-      res += "&apos;";
-      break;
-    case '<':
-      res += "&lt;";
-      break;
-    case '>':
-      res += "&gt;";
-      break;
-    default:
-      res += char(data[pos]);
-      break;
+namespace {
+
+const char *html_entity(char c) {
+  switch (c) {
+  case '&':
+    return "&amp;";
+  case '\"':
+    return "&quot;";
+  case '\'':
+    return "&apos;";
+  case '<':
+    return "&lt;";
+  case '>':
+    return "&gt;";
+  }
+  return nullptr;
+}
+
+} // namespace
+
+size_t escape_html(Print &out, const char *s) {
+  size_t n = 0;
+  const char *run = s;
+  for (; *s; ++s) {
+    const char *entity = html_entity(*s);
+    if (!entity) {
+      continue;
     }
+    n += out.write(run, s - run);
+    n += out.write(entity);
+    run = s + 1;
   }
-  return res;
+  return n + out.write(run, s - run);
 }
 
+uint32_t crc32(const void *data, size_t len, uint32_t crc) {
+  static const uint32_t table[16] = {
+      0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4,
+      0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+      0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
+  const uint8_t *p = (const uint8_t *)data;
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc = table[(crc ^ p[i]) & 0x0f] ^ (crc >> 4);
+    crc = table[(crc ^ (p[i] >> 4)) & 0x0f] ^ (crc >> 4);
+  }
+  return ~crc;
+}
+
+namespace {
+// Leaves `p` alone when there is no number or it overflows, the caller
+// then finds a digit where it expects '-' or the end and ignores the range.
+bool parse_size(const char *&p, size_t *res) {
+  const char *q = p;
+  if (*q < '0' || *q > '9') {
+    return false;
+  }
+  size_t v = 0;
+  for (; *q >= '0' && *q <= '9'; ++q) {
+    size_t d = *q - '0';
+    if (v > (SIZE_MAX - d) / 10) {
+      return false;
+    }
+    v = v * 10 + d;
+  }
+  p = q;
+  *res = v;
+  return true;
+}
+} // namespace
+
+HttpRange parse_http_range(const char *value, size_t size, size_t *start,
+                           size_t *end) {
+  if (strncmp(value, "bytes=", 6) != 0) {
+    return HttpRange::IGNORE;
+  }
+  const char *p = value + 6;
+  size_t first = 0, last = 0;
+  bool has_first = parse_size(p, &first);
+  if (*p++ != '-') {
+    return HttpRange::IGNORE;
+  }
+  bool has_last = parse_size(p, &last);
+  if ((!has_first && !has_last) || *p != 0) {
+    // multiple ranges are not supported, send the whole resource
+    return HttpRange::IGNORE;
+  }
+
+  if (!has_first) {
+    // suffix range, the last `last` bytes
+    if (last == 0 || size == 0) {
+      return HttpRange::UNSATISFIABLE;
+    }
+    *start = last < size ? size - last : 0;
+    *end = size;
+    return HttpRange::OK;
+  }
+
+  if (has_last && last < first) {
+    // syntactically invalid, RFC 7233 says to ignore the header
+    return HttpRange::IGNORE;
+  }
+  if (first >= size) {
+    return HttpRange::UNSATISFIABLE;
+  }
+  *start = first;
+  *end = (has_last && last < size) ? last + 1 : size;
+  return HttpRange::OK;
+}
+
+namespace {
+bool fs_mounted = false;
+int fs_users = 0;
+FsStats fs_st = {};
+
+bool fs_mount() {
+  if (fs_mounted) {
+    return true;
+  }
+  uint32_t start = micros();
+  fs_mounted = LittleFS.begin();
+  uint32_t t = micros() - start;
+  fs_st.mounts++;
+  fs_st.mount_us += t;
+  if (t > fs_st.max_mount_us) {
+    fs_st.max_mount_us = t;
+  }
+  if (!fs_mounted) {
+    LOGE("LittleFS.begin failed");
+  }
+  return fs_mounted;
+}
+} // namespace
+
 LittleFSOpener::LittleFSOpener() {
-  if (!LittleFS.begin()) {
-    log("LittleFS.begin failed");
+  fs_users++;
+  fs_st.opens++;
+  fs_mount();
+}
+
+LittleFSOpener::~LittleFSOpener() { fs_users--; }
+
+bool LittleFSOpener::ok() const { return fs_mounted; }
+
+FsStats fs_stats() { return fs_st; }
+
+void fs_unmount() {
+  if (!fs_mounted) {
+    return;
+  }
+  if (fs_users) {
+    LOGW("unmounting LittleFS with %d users", fs_users);
   }
+  LittleFS.end();
+  fs_mounted = false;
 }
-LittleFSOpener::~LittleFSOpener() { LittleFS.end(); }
 
 } // namespace utils
 } // namespace s28
\ No newline at end of file
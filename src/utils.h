@@ -1,18 +1,49 @@
 #ifndef s28_utils_h
 #define s28_utils_h
 
-#include <WString.h>
+#include <Print.h>
 
 namespace s28 {
 namespace utils {
     
-String escape_html(const String &data);
+// Prints `s` with the html special characters as entities; plain runs go
+// out in one write.
+size_t escape_html(Print &out, const char *s);
 
+// CRC-32 (IEEE), pass the previous result to continue a running CRC
+uint32_t crc32(const void *data, size_t len, uint32_t crc = 0);
+
+enum class HttpRange { IGNORE, OK, UNSATISFIABLE };
+
+// Parses a single "bytes=" Range header value against a resource of `size`
+// bytes. On OK, [*start, *end) is the requested part.
+HttpRange parse_http_range(const char *value, size_t size, size_t *start,
+                           size_t *end);
+
+// Holds LittleFS mounted while a file is in use. The first opener mounts
+// the filesystem and it stays mounted afterwards (a mount scans the
+// metadata blocks, it is not cheap); only fs_unmount() takes it down.
 struct LittleFSOpener {
   LittleFSOpener();
   ~LittleFSOpener();
+  LittleFSOpener(const LittleFSOpener &) = delete;
+  LittleFSOpener &operator=(const LittleFSOpener &) = delete;
+
+  bool ok() const;
 };
 
+struct FsStats {
+  uint32_t mounts;
+  uint32_t opens; // LittleFSOpener instances
+  uint32_t mount_us;
+  uint32_t max_mount_us;
+};
+
+FsStats fs_stats();
+
+// before a reset
+void fs_unmount();
+
 } // namespace utils
 } // namespace s28
 
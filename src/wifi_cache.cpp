@@ -0,0 +1,81 @@
+#include "wifi_cache.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <string.h>
+
+#include "logging.h"
+#include "rtc_mem.h"
+#include "utils.h"
+
+S28_LOG_MODULE(WIFI, "wifi")
+
+namespace s28 {
+namespace wifi_cache {
+
+namespace {
+
+const char *file_name = "/wifi";
+
+struct Record {
+  Lease lease;
+  uint32_t crc;
+};
+
+uint32_t ssid_crc(const char *ssid) {
+  return utils::crc32(ssid, strlen(ssid));
+}
+
+bool read_file(Lease *lease) {
+  utils::LittleFSOpener opener;
+  File f = LittleFS.open(file_name, "r");
+  Record r;
+  if (!f || f.read((uint8_t *)&r, sizeof(r)) != sizeof(r) ||
+      utils::crc32(&r.lease, sizeof(r.lease)) != r.crc) {
+    return false;
+  }
+  *lease = r.lease;
+  return true;
+}
+
+} // namespace
+
+bool load(const char *ssid, Lease *lease) {
+  bool found =
+      rtc_mem::read(rtc_mem::WIFI, lease, sizeof(*lease)) == sizeof(*lease);
+  if (!found) {
+    found = read_file(lease);
+    if (found) {
+      rtc_mem::write(rtc_mem::WIFI, lease, sizeof(*lease));
+    }
+  }
+  return found && lease->ssid_crc == ssid_crc(ssid) && lease->channel;
+}
+
+void save(const char *ssid, Lease lease) {
+  lease.ssid_crc = ssid_crc(ssid);
+  lease.reserved = 0;
+  rtc_mem::write(rtc_mem::WIFI, &lease, sizeof(lease));
+
+  Lease old;
+  if (read_file(&old) && memcmp(&old, &lease, sizeof(lease)) == 0) {
+    return;
+  }
+  utils::LittleFSOpener opener;
+  File f = LittleFS.open(file_name, "w");
+  Record r = {lease, utils::crc32(&lease, sizeof(lease))};
+  if (!f || f.write((const uint8_t *)&r, sizeof(r)) != sizeof(r)) {
+    LOGW("saving %s failed", file_name);
+    return;
+  }
+  LOGD("lease saved, channel %d", int(lease.channel));
+}
+
+void forget() {
+  rtc_mem::invalidate(rtc_mem::WIFI);
+  utils::LittleFSOpener opener;
+  LittleFS.remove(file_name);
+}
+
+} // namespace wifi_cache
+} // namespace s28
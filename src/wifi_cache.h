@@ -0,0 +1,34 @@
+#ifndef s28_wifi_cache_h
+#define s28_wifi_cache_h
+
+#include <stdint.h>
+
+namespace s28 {
+namespace wifi_cache {
+
+// What the last successful connection needed: the access point (so no
+// channel scan is required) and the DHCP lease (so no DHCP round trip).
+struct Lease {
+  uint32_t ssid_crc; // the lease belongs to this SSID
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t netmask;
+  uint32_t dns;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t reserved;
+};
+
+// RTC memory first, then /wifi on LittleFS
+bool load(const char *ssid, Lease *lease);
+
+// Updates the RTC copy; the flash copy only when it changed.
+void save(const char *ssid, Lease lease);
+
+// the cached lease did not work
+void forget();
+
+} // namespace wifi_cache
+} // namespace s28
+
+#endif
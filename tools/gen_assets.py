@@ -0,0 +1,75 @@
+"""Generates the PROGMEM headers for the config app from assets/.
+
+Runs as a PlatformIO pre-build script (extra_scripts in platformio.ini) and
+can also be run by hand:
+
+    python3 tools/gen_assets.py
+
+Templates containing $<c> placeholders are embedded as they are, static
+files are gzipped. Every asset gets an ETag derived from its content.
+A header is rewritten only when its content changes.
+"""
+
+import gzip
+import hashlib
+import os
+
+# (source, header, kind); "template" assets are expanded at runtime and
+# cannot be compressed
+ASSETS = [
+    ("assets/setup.html", "src/apps/config/setup_html.h", "template"),
+    ("assets/bye.html", "src/apps/config/bye_html.h", "gzip"),
+    ("assets/style.css", "src/apps/config/style_css.h", "gzip"),
+]
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 12):
+        chunk = data[i:i + 12]
+        lines.append("  " + ", ".join("0x%02x" % b for b in chunk))
+    return ",\n".join(lines)
+
+
+def render(src, kind, raw):
+    name = "assets_" + os.path.basename(src).replace(".", "_").replace("-", "_")
+    etag = hashlib.sha1(raw).hexdigest()[:16]
+    if kind == "gzip":
+        # mtime=0 keeps the output reproducible
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        name += "_gz"
+    else:
+        data = raw
+    out = []
+    out.append("// generated by tools/gen_assets.py from %s, do not edit" % src)
+    out.append("// %d bytes, %s" % (len(raw),
+               "gzipped to %d bytes" % len(data) if kind == "gzip"
+               else "not compressed"))
+    out.append("static const unsigned char %s[] PROGMEM = {" % name)
+    out.append(c_array(data))
+    out.append("};")
+    out.append("static const size_t %s_len = %d;" % (name, len(data)))
+    out.append("static const char %s_etag[] = \"\\\"%s\\\"\";" % (name, etag))
+    return "\n".join(out) + "\n"
+
+
+def generate(root):
+    for src, header, kind in ASSETS:
+        with open(os.path.join(root, src), "rb") as f:
+            raw = f.read()
+        text = render(src, kind, raw)
+        path = os.path.join(root, header)
+        if os.path.exists(path):
+            with open(path) as f:
+                if f.read() == text:
+                    continue
+        with open(path, "w") as f:
+            f.write(text)
+        print("gen_assets: %s -> %s" % (src, header))
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    generate(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
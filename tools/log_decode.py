@@ -0,0 +1,158 @@
+"""Decodes binary log records (S28_LOG_BINARY builds) back into text.
+
+    python3 tools/log_decode.py .pio/build/nodemcuv2/firmware.elf log.bin
+    cat /dev/ttyUSB0 | python3 tools/log_decode.py firmware.elf
+
+The input may be a serial capture or the /log file; plain text between the
+records is passed through. The record layout is described in
+src/logging.cpp.
+"""
+
+import re
+import struct
+import sys
+
+SYNC = 0x1E
+LEVELS = "DIWE"
+
+
+class Elf:
+    """Reads NUL terminated strings from the loadable sections of an ELF."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        is64 = d[4] == 2
+        end = "<" if d[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", d, 0x28)
+            shentsize, shnum = struct.unpack_from(end + "HH", d, 0x3A)
+            fmt = end + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(end + "I", d, 0x20)
+            shentsize, shnum = struct.unpack_from(end + "HH", d, 0x2E)
+            fmt = end + "IIIIII"
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(
+                fmt, d, shoff + i * shentsize)
+            # SHF_ALLOC sections with content (not SHT_NOBITS)
+            if flags & 2 and sh_type != 8 and addr:
+                self.sections.append((addr, offset, size))
+
+    def string(self, addr):
+        for start, offset, size in self.sections:
+            if start <= addr < start + size:
+                pos = offset + addr - start
+                stop = self.data.index(b"\0", pos)
+                return self.data[pos:stop].decode("utf-8", "replace")
+        return None
+
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?([hlz]*)([a-zA-Z%])")
+
+
+def format_record(fmt, args):
+    out = []
+    pos = 0
+    last = 0
+
+    def take(n):
+        nonlocal pos
+        if pos + n > len(args):
+            raise IndexError
+        v = args[pos:pos + n]
+        pos += n
+        return v
+
+    try:
+        for m in CONVERSION.finditer(fmt):
+            out.append(fmt[last:m.start()])
+            last = m.end()
+            flags, width, prec, length, conv = m.groups()
+            if conv == "%":
+                out.append("%")
+                continue
+            if width == "*":
+                width = str(struct.unpack("<i", take(4))[0])
+            if prec == "*":
+                prec = str(struct.unpack("<i", take(4))[0])
+            spec = "%" + flags + (width or "") + ("." + prec if prec else "")
+            if conv in "diuxXoc":
+                signed = conv in "di"
+                if length.count("l") >= 2:
+                    v, = struct.unpack("<q" if signed else "<Q", take(8))
+                else:
+                    v, = struct.unpack("<i" if signed else "<I", take(4))
+                out.append((spec + ("d" if conv == "u" else conv)) % v)
+            elif conv in "feEgG":
+                out.append((spec + conv) % struct.unpack("<d", take(8))[0])
+            elif conv == "s":
+                n = take(1)[0]
+                out.append((spec + "s") % take(n).decode("utf-8", "replace"))
+            elif conv == "p":
+                out.append("0x%08x" % struct.unpack("<I", take(4))[0])
+            else:
+                break
+        out.append(fmt[last:])
+    except IndexError:
+        out.append("<truncated>")
+    return "".join(out).rstrip("\n")
+
+
+def decode(elf, data, write):
+    i = 0
+    text = bytearray()
+    while i < len(data):
+        b = data[i]
+        if b != SYNC or i + 2 > len(data):
+            text.append(b)
+            i += 1
+            continue
+        n = data[i + 1]
+        payload = data[i + 2:i + 2 + n]
+        if len(payload) != n or i + 2 + n >= len(data) \
+                or (sum(payload) & 0xFF) != data[i + 2 + n] or n < 13:
+            # not a record, or a torn one at the end of the capture
+            text.append(b)
+            i += 1
+            continue
+        addr, ts, level, tag_addr = struct.unpack_from("<IIBI", payload)
+        fmt = elf.string(addr)
+        if fmt is None:
+            line = "<unknown format at 0x%08x>" % addr
+        else:
+            line = format_record(fmt, payload[13:])
+        if tag_addr:
+            tag = elf.string(tag_addr) or "?"
+            level = LEVELS[level] if level < len(LEVELS) else "?"
+            line = "%s %s: %s" % (level, tag, line)
+        write(text.decode("utf-8", "replace"))
+        text = bytearray()
+        write("[%lu.%03lu] %s\n" % (ts // 1000, ts % 1000, line))
+        i += 3 + n
+        # the /log file puts a newline after every record
+        if i < len(data) and data[i] == 0x0A:
+            i += 1
+    write(text.decode("utf-8", "replace"))
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(__doc__, file=sys.stderr)
+        return 1
+    elf = Elf(sys.argv[1])
+    if len(sys.argv) == 3:
+        with open(sys.argv[2], "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    decode(elf, data, sys.stdout.write)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
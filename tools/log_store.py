@@ -0,0 +1,96 @@
+"""Decodes the persistent log store (src/log_store.cpp).
+
+    curl -s http://192.168.100.1/logs > logs.bin
+    python3 tools/log_store.py logs.bin [--boots N]
+
+The input is the /logs dump or segment files (/logs.0 ...) given in
+oldest-first order. Torn blocks left by a reset are skipped. Binary log
+records (S28_LOG_BINARY) pass through and can be piped to log_decode.py.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+SEGMENT_MAGIC = b"S28L"
+SEGMENT_HEADER = struct.Struct("<4sIHH")
+BLOCK_HEADER = struct.Struct("<BBHHHI")
+BLOCK_MAGIC = 0xB5
+BLOCK_COMPRESSED = 0x01
+MIN_MATCH = 3
+
+
+def lz_decompress(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        flags = data[i]
+        i += 1
+        for bit in range(8):
+            if i >= len(data):
+                break
+            if flags & (1 << bit):
+                v = data[i] | (data[i + 1] << 8)
+                i += 2
+                off = (v >> 4) + 1
+                for _ in range((v & 0xF) + MIN_MATCH):
+                    out.append(out[-off])
+            else:
+                out.append(data[i])
+                i += 1
+    return bytes(out)
+
+
+def blocks(data):
+    """Yields (boot, raw bytes) of every intact block."""
+    p = 0
+    while p < len(data):
+        if data[p:p + 4] == SEGMENT_MAGIC and p + SEGMENT_HEADER.size <= len(data):
+            p += SEGMENT_HEADER.size
+            continue
+        if data[p] == BLOCK_MAGIC and p + BLOCK_HEADER.size <= len(data):
+            _, flags, raw_len, data_len, boot, crc = \
+                BLOCK_HEADER.unpack_from(data, p)
+            start = p + BLOCK_HEADER.size
+            payload = data[start:start + data_len]
+            if len(payload) == data_len and zlib.crc32(payload) == crc:
+                raw = lz_decompress(payload) \
+                    if flags & BLOCK_COMPRESSED else payload
+                if len(raw) == raw_len:
+                    yield boot, raw
+                    p = start + data_len
+                    continue
+        # torn or foreign bytes, resynchronize
+        p += 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("files", nargs="+")
+    ap.add_argument("--boots", type=int, default=0,
+                    help="only the last N boots")
+    args = ap.parse_args()
+
+    data = b""
+    for name in args.files:
+        with open(name, "rb") as f:
+            data += f.read()
+
+    per_boot = []
+    for boot, raw in blocks(data):
+        if not per_boot or per_boot[-1][0] != boot:
+            per_boot.append((boot, bytearray()))
+        per_boot[-1][1].extend(raw)
+    if args.boots:
+        per_boot = per_boot[-args.boots:]
+
+    out = sys.stdout.buffer
+    for boot, raw in per_boot:
+        out.write(b"=== boot %d ===\n" % boot)
+        out.write(raw)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,193 @@
+"""Builds ready-to-flash LittleFS images with a device config.
+
+    python3 tools/provision.py devices.csv -o images/ [-j 8] \\
+        [--fingerprints fingerprints.csv]
+
+devices.csv has a header row with the columns ssid, password, collector,
+token and optionally fingerprint, ip, gateway, netmask, dns and name (the
+image file name, default: row number). --fingerprints takes the output of
+tools/tls/fleet_probe and fills in missing fingerprints by collector.
+
+Each image holds /cfg.0, the binary config record read_startup_args()
+loads (src/args.cpp). Rows are checked against the firmware's own rules
+first; any invalid row stops the run before an image is written. The
+images are built by mklittlefs in parallel; flash one with
+    esptool.py write_flash 0xEB000 images/NAME.bin
+The filesystem geometry defaults match the 1M (64K FS) layout the
+sonoff_basic board uses, override it for other layouts.
+"""
+
+import argparse
+import concurrent.futures
+import csv
+import ipaddress
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import zlib
+
+RECORD_MAGIC = 0x43383253  # "S28C"
+RECORD_FORMAT = 1
+RECORD_HEADER = struct.Struct("<IHHII")
+MAX_RECORD = 400  # MAX_STARTUP_ARGS_RECORD
+VERSION = "1001"  # StartupArgs::VERSION
+
+# (tag, id, max_len) as in the fields table of src/args.cpp
+FIELDS = [
+    (1, "flags", 4),
+    (2, "version", 8),
+    (3, "ssid", 32),
+    (4, "password", 64),
+    (5, "collector", 64),
+    (6, "token", 64),
+    (7, "fingerprint", 59),
+    (8, "ip", 15),
+    (9, "gateway", 15),
+    (10, "netmask", 15),
+    (11, "dns", 15),
+]
+
+FINGERPRINT_RE = re.compile(r"^[0-9A-F]{2}( [0-9A-F]{2}){19}$")
+
+
+def is_ipv4(value):
+    try:
+        ipaddress.IPv4Address(value)
+        return True
+    except ValueError:
+        return False
+
+
+def check(row):
+    """Returns the problems of one row; check_args() plus field limits."""
+    errors = []
+    for _, key, max_len in FIELDS:
+        n = len(row.get(key, "").encode())
+        if n > max_len:
+            errors.append("%s is %d bytes, at most %d" % (key, n, max_len))
+    if not row.get("ssid"):
+        errors.append("SSID not configured")
+    if len(row.get("token", "")) < 5:
+        errors.append("Blynk token not configured")
+    collector = row.get("collector", "")
+    custom = collector not in ("", "*")
+    if custom and not is_ipv4(collector):
+        errors.append("collector must be an IPv4 address or *")
+    fingerprint = row.get("fingerprint", "")
+    if fingerprint and not FINGERPRINT_RE.match(fingerprint):
+        errors.append("fingerprint must look like 'AA BB ..' (20 bytes)")
+    if row.get("ip"):
+        for key in ("ip", "gateway"):
+            if not is_ipv4(row.get(key, "")):
+                errors.append("%s is not an IPv4 address" % key)
+        for key in ("netmask", "dns"):
+            if row.get(key) and not is_ipv4(row[key]):
+                errors.append("%s is not an IPv4 address" % key)
+    return errors
+
+
+def encode_record(row, seq=1):
+    """The /cfg.N file content, as write_record() produces it."""
+    values = dict(row, flags="0", version=VERSION)
+    payload = bytearray()
+    for tag, key, _ in FIELDS:
+        value = values.get(key, "").encode()
+        payload += bytes((tag, len(value))) + value
+    if len(payload) > MAX_RECORD:
+        raise ValueError("record is %d bytes" % len(payload))
+    header = RECORD_HEADER.pack(RECORD_MAGIC, RECORD_FORMAT, len(payload),
+                                seq, 0)
+    crc = zlib.crc32(payload, zlib.crc32(header))
+    return RECORD_HEADER.pack(RECORD_MAGIC, RECORD_FORMAT, len(payload), seq,
+                              crc) + payload
+
+
+def find_mklittlefs(name):
+    if name:
+        return name
+    found = shutil.which("mklittlefs")
+    if found:
+        return found
+    pio = os.path.expanduser("~/.platformio/packages/tool-mklittlefs/mklittlefs")
+    return pio if os.path.exists(pio) else None
+
+
+def build_image(mklittlefs, geometry, name, record, out_dir):
+    with tempfile.TemporaryDirectory() as tmp:
+        with open(os.path.join(tmp, "cfg.0"), "wb") as f:
+            f.write(record)
+        image = os.path.join(out_dir, name + ".bin")
+        subprocess.run([mklittlefs, "-c", tmp, "-b", str(geometry.block),
+                        "-p", str(geometry.page), "-s", str(geometry.size),
+                        image], check=True, stdout=subprocess.DEVNULL)
+        return image
+
+
+def load_fingerprints(name):
+    with open(name, newline="") as f:
+        return {r["collector"]: r["fingerprint"] for r in csv.DictReader(f)
+                if r.get("status") == "ok"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("csv")
+    ap.add_argument("-o", "--out", default="images")
+    ap.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+    ap.add_argument("--fingerprints", help="fleet_probe output")
+    ap.add_argument("--mklittlefs", help="path to mklittlefs")
+    ap.add_argument("--records-only", action="store_true",
+                    help="write the cfg.0 records instead of images")
+    ap.add_argument("--size", type=lambda v: int(v, 0), default=0x10000)
+    ap.add_argument("--block", type=lambda v: int(v, 0), default=4096)
+    ap.add_argument("--page", type=lambda v: int(v, 0), default=256)
+    args = ap.parse_args()
+
+    with open(args.csv, newline="") as f:
+        rows = [{k.strip(): (v or "").strip() for k, v in r.items() if k}
+                for r in csv.DictReader(f)]
+    fingerprints = load_fingerprints(args.fingerprints) \
+        if args.fingerprints else {}
+
+    jobs = []
+    bad = 0
+    for i, row in enumerate(rows, 1):
+        if not row.get("fingerprint"):
+            row["fingerprint"] = fingerprints.get(row.get("collector"), "")
+        name = row.pop("name", "") or "%04d" % i
+        errors = check(row)
+        for e in errors:
+            print("%s (row %d): %s" % (name, i, e), file=sys.stderr)
+        bad += bool(errors)
+        if not errors:
+            jobs.append((name, encode_record(row)))
+    if bad:
+        print("%d invalid row(s), nothing written" % bad, file=sys.stderr)
+        return 1
+
+    os.makedirs(args.out, exist_ok=True)
+    if args.records_only:
+        for name, record in jobs:
+            with open(os.path.join(args.out, name + ".cfg"), "wb") as f:
+                f.write(record)
+        print("%d record(s) written to %s" % (len(jobs), args.out))
+        return 0
+
+    mklittlefs = find_mklittlefs(args.mklittlefs)
+    if not mklittlefs:
+        print("mklittlefs not found, use --mklittlefs", file=sys.stderr)
+        return 1
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as pool:
+        futures = [pool.submit(build_image, mklittlefs, args, name, record,
+                               args.out) for name, record in jobs]
+        for fut in concurrent.futures.as_completed(futures):
+            print(fut.result())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,308 @@
+// Reads the certificate fingerprints of many collectors at once, with the
+// same probe the firmware runs (src/probe_engine.cpp), over non-blocking
+// sockets and epoll.
+//   ./fleet_probe [-j PARALLEL] [-t TIMEOUT_MS] [-o OUT.csv] COLLECTORS
+//
+// COLLECTORS has one "host" or "host:port" per line (default port 9443),
+// '#' starts a comment, "-" reads stdin. The output is CSV:
+//   collector,port,fingerprint,status,connect_ms,probe_ms
+// with the fingerprint written the way StartupArgs::fingerprint stores it
+// ("AA BB ..").
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "net.h"
+#include "probe_engine.h"
+
+using namespace s28;
+using net::now_ms;
+
+namespace {
+
+struct Target {
+  std::string host;
+  std::string port;
+
+  // results
+  const char *status = "pending";
+  uint8_t fingerprint[20];
+  double connect_ms = 0;
+  double probe_ms = 0;
+};
+
+struct AddrInfoFree {
+  void operator()(addrinfo *ai) const { freeaddrinfo(ai); }
+};
+
+struct Job {
+  Target *target;
+  std::unique_ptr<addrinfo, AddrInfoFree> addrs;
+  addrinfo *addr = nullptr; // the address being connected
+  int fd = -1;
+  bool connecting = true;
+  double start = 0;
+  double connected = 0;
+  double deadline = 0;
+  probe::Engine engine;
+  std::unique_ptr<net::SocketTransport> transport;
+};
+
+std::vector<Target> read_targets(FILE *in) {
+  std::vector<Target> targets;
+  char line[512];
+  while (fgets(line, sizeof(line), in)) {
+    char *end = strpbrk(line, "#,\r\n");
+    if (end) {
+      *end = 0;
+    }
+    char host[256], port[16] = "9443";
+    if (sscanf(line, " %255[^: \t]:%15s", host, port) < 1 ||
+        strcmp(host, "collector") == 0) { // a CSV header
+      continue;
+    }
+    Target t;
+    t.host = host;
+    t.port = port;
+    targets.push_back(t);
+  }
+  return targets;
+}
+
+bool resolve(Job *job) {
+  addrinfo hints, *ai;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(job->target->host.c_str(), job->target->port.c_str(),
+                  &hints, &ai) != 0) {
+    return false;
+  }
+  job->addrs.reset(ai);
+  return true;
+}
+
+// Non-blocking connect to the address after job->addr (the first one
+// initially); -1 once every address failed immediately.
+int connect_next(Job *job) {
+  addrinfo *ai = job->addr ? job->addr->ai_next : job->addrs.get();
+  for (; ai; ai = ai->ai_next) {
+    job->addr = ai;
+    int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK,
+                    ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0 && errno != EINPROGRESS) {
+      close(fd);
+      continue;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+  }
+  return -1;
+}
+
+struct Fleet {
+  Fleet(std::vector<Target> &targets, size_t parallel, double timeout_ms)
+      : targets(targets), parallel(parallel), timeout_ms(timeout_ms),
+        ep(epoll_create1(0)) {}
+
+  ~Fleet() { close(ep); }
+
+  void run() {
+    while (next < targets.size() || !active.empty()) {
+      while (next < targets.size() && active.size() < parallel) {
+        start(&targets[next++]);
+      }
+      epoll_event events[64];
+      int n = epoll_wait(ep, events, 64, 20);
+      for (int i = 0; i < n; ++i) {
+        Job *job = (Job *)events[i].data.ptr;
+        if (job->connecting) {
+          connected(job);
+        } else {
+          step(job);
+        }
+      }
+      expire();
+    }
+  }
+
+  void start(Target *t) {
+    std::unique_ptr<Job> job(new Job());
+    job->target = t;
+    job->start = now_ms();
+    job->deadline = job->start + timeout_ms;
+    if (resolve(job.get())) {
+      job->fd = connect_next(job.get());
+    }
+    if (job->fd < 0) {
+      t->status = "connect_failed";
+      return;
+    }
+    watch(job.get(), EPOLLOUT, EPOLL_CTL_ADD);
+    active.push_back(std::move(job));
+  }
+
+  void watch(Job *job, uint32_t events, int op = EPOLL_CTL_MOD) {
+    epoll_event ev = {};
+    ev.events = events;
+    ev.data.ptr = job;
+    epoll_ctl(ep, op, job->fd, &ev);
+  }
+
+  void connected(Job *job) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(job->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err) {
+      // e.g. an IPv6 address without a route, try the next one
+      int fd = connect_next(job);
+      if (fd < 0) {
+        finish(job, "connect_failed");
+        return;
+      }
+      epoll_ctl(ep, EPOLL_CTL_DEL, job->fd, nullptr);
+      close(job->fd);
+      job->fd = fd;
+      watch(job, EPOLLOUT, EPOLL_CTL_ADD);
+      return;
+    }
+    job->connecting = false;
+    job->connected = now_ms();
+    job->target->connect_ms = job->connected - job->start;
+    job->transport.reset(new net::SocketTransport(job->fd));
+    job->engine.start(job->target->host.c_str(), job->target->fingerprint,
+                      uint32_t(job->connected),
+                      uint32_t(job->deadline - job->connected));
+    step(job);
+  }
+
+  void step(Job *job) {
+    switch (job->engine.step(*job->transport, uint32_t(now_ms()))) {
+    case probe::PENDING:
+      watch(job, job->engine.wants_write() ? EPOLLOUT : EPOLLIN);
+      return;
+    case probe::OK:
+      job->target->probe_ms = now_ms() - job->connected;
+      finish(job, "ok");
+      return;
+    case probe::TIMEOUT:
+      finish(job, "timeout");
+      return;
+    case probe::FAILED:
+      finish(job, "tls_failed");
+      return;
+    }
+  }
+
+  void expire() {
+    double now = now_ms();
+    for (size_t i = 0; i < active.size();) {
+      Job *job = active[i].get();
+      if (now >= job->deadline) {
+        finish(job, "timeout"); // removes active[i]
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  void finish(Job *job, const char *status) {
+    job->target->status = status;
+    epoll_ctl(ep, EPOLL_CTL_DEL, job->fd, nullptr);
+    close(job->fd);
+    for (auto it = active.begin(); it != active.end(); ++it) {
+      if (it->get() == job) {
+        active.erase(it);
+        break;
+      }
+    }
+  }
+
+  std::vector<Target> &targets;
+  size_t parallel;
+  double timeout_ms;
+  int ep;
+  size_t next = 0;
+  std::vector<std::unique_ptr<Job>> active;
+};
+
+void usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [-j PARALLEL] [-t TIMEOUT_MS] [-o OUT.csv] COLLECTORS\n",
+          name);
+  exit(2);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t parallel = 64;
+  double timeout_ms = 10000;
+  const char *out_name = nullptr;
+  int opt;
+  while ((opt = getopt(argc, argv, "j:t:o:")) != -1) {
+    switch (opt) {
+    case 'j':
+      parallel = strtoul(optarg, nullptr, 10);
+      break;
+    case 't':
+      timeout_ms = atof(optarg);
+      break;
+    case 'o':
+      out_name = optarg;
+      break;
+    default:
+      usage(argv[0]);
+    }
+  }
+  if (optind + 1 != argc || parallel == 0) {
+    usage(argv[0]);
+  }
+
+  FILE *in = strcmp(argv[optind], "-") == 0 ? stdin : fopen(argv[optind], "r");
+  if (!in) {
+    perror(argv[optind]);
+    return 1;
+  }
+  std::vector<Target> targets = read_targets(in);
+  FILE *out = out_name ? fopen(out_name, "w") : stdout;
+  if (!out) {
+    perror(out_name);
+    return 1;
+  }
+
+  double start = now_ms();
+  Fleet(targets, parallel, timeout_ms).run();
+  double elapsed = now_ms() - start;
+
+  int ok = 0;
+  fprintf(out, "collector,port,fingerprint,status,connect_ms,probe_ms\n");
+  for (const Target &t : targets) {
+    fprintf(out, "%s,%s,", t.host.c_str(), t.port.c_str());
+    bool good = strcmp(t.status, "ok") == 0;
+    for (int i = 0; good && i < 20; ++i) {
+      fprintf(out, i ? " %02X" : "%02X", t.fingerprint[i]);
+    }
+    fprintf(out, ",%s,%.1f,%.1f\n", t.status, t.connect_ms, t.probe_ms);
+    ok += good;
+  }
+  fprintf(stderr, "%d/%zu collectors probed in %.0f ms\n", ok,
+          targets.size(), elapsed);
+  return ok == int(targets.size()) ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+// Cost of a full TLS client handshake per cipher suite and per profile
+// (src/tls_profile.cpp), with the BearSSL client set up as in
+// snippets/client_get_fingerprint.c.
+//   ./handshake_bench HOST PORT [RUNS]
+//
+// For every suite it reports the client CPU time (the server runs in
+// another process), the bytes sent and received, and the peak stack. The
+// engine contexts are static, BearSSL itself never allocates, so peak RAM
+// is the printed context size plus the stack column.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net.h"
+#include "tls_profile.h"
+
+using namespace s28;
+using net::now_ms;
+
+namespace {
+
+// Accepts any certificate: the benchmark measures cost, not trust.
+struct AnyCert {
+  const br_x509_class *vtable;
+  br_x509_decoder_context dc;
+  bool done;
+};
+
+void any_start_chain(const br_x509_class **ctx, const char *server_name) {
+  ((AnyCert *)ctx)->done = false;
+}
+
+void any_start_cert(const br_x509_class **ctx, uint32_t length) {
+  AnyCert *xc = (AnyCert *)ctx;
+  if (!xc->done) {
+    br_x509_decoder_init(&xc->dc, 0, 0);
+  }
+}
+
+void any_append(const br_x509_class **ctx, const unsigned char *buf,
+                size_t len) {
+  AnyCert *xc = (AnyCert *)ctx;
+  if (!xc->done) {
+    br_x509_decoder_push(&xc->dc, buf, len);
+  }
+}
+
+void any_end_cert(const br_x509_class **ctx) { ((AnyCert *)ctx)->done = true; }
+
+unsigned any_end_chain(const br_x509_class **ctx) {
+  return br_x509_decoder_last_error(&((AnyCert *)ctx)->dc);
+}
+
+const br_x509_pkey *any_get_pkey(const br_x509_class *const *ctx,
+                                 unsigned *usages) {
+  AnyCert *xc = (AnyCert *)ctx;
+  if (usages) {
+    *usages = BR_KEYTYPE_KEYX | BR_KEYTYPE_SIGN;
+  }
+  return br_x509_decoder_get_pkey(&xc->dc);
+}
+
+const br_x509_class any_vtable = {sizeof(AnyCert), any_start_chain,
+                                  any_start_cert,  any_append,
+                                  any_end_cert,    any_end_chain,
+                                  any_get_pkey};
+
+struct Conn {
+  int fd;
+  size_t bytes_in;
+  size_t bytes_out;
+};
+
+int sock_read(void *ctx, unsigned char *buf, size_t len) {
+  Conn *c = (Conn *)ctx;
+  for (;;) {
+    ssize_t n = read(c->fd, buf, len);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    c->bytes_in += n;
+    return int(n);
+  }
+}
+
+int sock_write(void *ctx, const unsigned char *buf, size_t len) {
+  Conn *c = (Conn *)ctx;
+  for (;;) {
+    ssize_t n = write(c->fd, buf, len);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    c->bytes_out += n;
+    return int(n);
+  }
+}
+
+br_ssl_client_context cc;
+AnyCert xc;
+unsigned char iobuf[BR_SSL_BUFSIZE_MONO];
+
+struct Job {
+  const char *host;
+  const char *port;
+  tls_profile::Profile profile;
+  uint16_t suite; // 0: the whole profile
+
+  bool ok;
+  int error;
+  uint16_t negotiated;
+  double wall_ms;
+  double cpu_ms;
+  Conn conn;
+};
+
+void *handshake(void *arg) {
+  Job *job = (Job *)arg;
+  double start = now_ms();
+  job->conn = {net::host_connect(job->host, job->port), 0, 0};
+  if (job->conn.fd < 0) {
+    job->ok = false;
+    job->error = -1;
+    return nullptr;
+  }
+
+  double cpu_start = now_ms(CLOCK_THREAD_CPUTIME_ID);
+  tls_profile::init_client(&cc, job->profile);
+  if (job->suite) {
+    br_ssl_engine_set_suites(&cc.eng, &job->suite, 1);
+  }
+  xc.vtable = &any_vtable;
+  br_ssl_engine_set_x509(&cc.eng, &xc.vtable);
+  br_ssl_engine_set_buffer(&cc.eng, iobuf, sizeof(iobuf), 0);
+  br_ssl_client_reset(&cc, job->host, 0);
+
+  br_sslio_context ioc;
+  br_sslio_init(&ioc, &cc.eng, sock_read, &job->conn, sock_write, &job->conn);
+  job->ok = br_sslio_flush(&ioc) == 0;
+  job->cpu_ms = now_ms(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+  job->wall_ms = now_ms() - start;
+  job->error = br_ssl_engine_last_error(&cc.eng);
+  br_ssl_session_parameters session;
+  br_ssl_engine_get_session_parameters(&cc.eng, &session);
+  job->negotiated = session.cipher_suite;
+  close(job->conn.fd);
+  return nullptr;
+}
+
+constexpr size_t STACK_SIZE = 256 * 1024;
+constexpr unsigned char STACK_FILL = 0xa5;
+
+// Runs the handshake on a painted stack; returns the bytes of it used.
+size_t run(Job *job) {
+  static unsigned char stack[STACK_SIZE] __attribute__((aligned(64)));
+  memset(stack, STACK_FILL, sizeof(stack));
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstack(&attr, stack, sizeof(stack));
+  pthread_t thread;
+  if (pthread_create(&thread, &attr, handshake, job) != 0) {
+    perror("pthread_create");
+    exit(1);
+  }
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+
+  size_t untouched = 0;
+  while (untouched < sizeof(stack) && stack[untouched] == STACK_FILL) {
+    ++untouched;
+  }
+  return sizeof(stack) - untouched;
+}
+
+struct SuiteName {
+  uint16_t id;
+  const char *name;
+};
+
+const SuiteName suite_names[] = {
+    {BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
+     "ECDHE_ECDSA_CHACHA20_POLY1305"},
+    {BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
+     "ECDHE_RSA_CHACHA20_POLY1305"},
+    {BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+     "ECDHE_ECDSA_AES_128_GCM_SHA256"},
+    {BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256, "ECDHE_RSA_AES_128_GCM_SHA256"},
+    {BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384,
+     "ECDHE_ECDSA_AES_256_GCM_SHA384"},
+    {BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384, "ECDHE_RSA_AES_256_GCM_SHA384"},
+    {BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256,
+     "ECDHE_ECDSA_AES_128_CBC_SHA256"},
+    {BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256, "ECDHE_RSA_AES_128_CBC_SHA256"},
+    {BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA, "ECDHE_ECDSA_AES_128_CBC_SHA"},
+    {BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA, "ECDHE_RSA_AES_128_CBC_SHA"},
+    {BR_TLS_RSA_WITH_AES_128_GCM_SHA256, "RSA_AES_128_GCM_SHA256"},
+    {BR_TLS_RSA_WITH_AES_128_CBC_SHA, "RSA_AES_128_CBC_SHA"},
+};
+
+const char *suite_name(uint16_t id) {
+  for (const SuiteName &s : suite_names) {
+    if (s.id == id) {
+      return s.name;
+    }
+  }
+  static char buf[8];
+  snprintf(buf, sizeof(buf), "0x%04X", id);
+  return buf;
+}
+
+void report(const char *label, Job job, int runs) {
+  double wall = 0, cpu = 0;
+  size_t stack = 0;
+  int ok = 0;
+  for (int i = 0; i < runs; ++i) {
+    Job j = job;
+    size_t used = run(&j);
+    if (!j.ok) {
+      printf("%-34s failed, error %d\n", label, j.error);
+      return;
+    }
+    ++ok;
+    wall += j.wall_ms;
+    cpu += j.cpu_ms;
+    stack = used > stack ? used : stack;
+    job.conn = j.conn;
+    job.negotiated = j.negotiated;
+  }
+  printf("%-34s %9.2f %9.2f %7zu %7zu %7zu  %s\n", label, wall / ok, cpu / ok,
+         job.conn.bytes_out, job.conn.bytes_in, stack,
+         suite_name(job.negotiated));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s HOST PORT [RUNS]\n", argv[0]);
+    return 2;
+  }
+  int runs = argc > 3 ? atoi(argv[3]) : 5;
+
+  printf("context %zu bytes (client %zu, x509 %zu), iobuf %zu bytes\n",
+         sizeof(cc) + sizeof(xc), sizeof(cc), sizeof(xc), sizeof(iobuf));
+  printf("%-34s %9s %9s %7s %7s %7s  %s\n", "offer", "wall ms", "cpu ms",
+         "out", "in", "stack", "negotiated");
+
+  const tls_profile::Profile profiles[] = {tls_profile::MINIMAL,
+                                           tls_profile::COMPAT};
+  for (tls_profile::Profile p : profiles) {
+    char label[40];
+    snprintf(label, sizeof(label), "profile %s", tls_profile::name(p));
+    report(label, {argv[1], argv[2], p, 0}, runs);
+  }
+
+  size_t count;
+  const uint16_t *suites = tls_profile::suites(tls_profile::COMPAT, &count);
+  for (size_t i = 0; i < count; ++i) {
+    report(suite_name(suites[i]),
+           {argv[1], argv[2], tls_profile::COMPAT, suites[i]}, runs);
+  }
+  return 0;
+}
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Runs handshake_bench against a throwaway local openssl s_server holding
+# both an ECDSA (P-256) and an RSA-2048 certificate, so every suite can be
+# negotiated. Point handshake_bench at a real collector to see what it
+# supports: ./handshake_bench collector.example.com 9443
+#   ./handshake_bench.sh [RUNS] [PORT]
+set -e
+
+RUNS=${1:-5}
+PORT=${2:-19444}
+DIR=$(mktemp -d)
+trap 'kill $SERVER 2>/dev/null; rm -rf "$DIR"' EXIT
+
+openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes \
+  -subj /CN=localhost -days 1 -keyout "$DIR/ec.key" -out "$DIR/ec.pem" \
+  2>/dev/null
+openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=localhost -days 1 \
+  -keyout "$DIR/rsa.key" -out "$DIR/rsa.pem" 2>/dev/null
+openssl s_server -quiet -www -accept "$PORT" -cert "$DIR/rsa.pem" \
+  -key "$DIR/rsa.key" -dcert "$DIR/ec.pem" -dkey "$DIR/ec.key" \
+  >/dev/null 2>&1 &
+SERVER=$!
+sleep 0.5
+
+./handshake_bench 127.0.0.1 "$PORT" "$RUNS"
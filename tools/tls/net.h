@@ -0,0 +1,80 @@
+#ifndef s28_tools_tls_net_h
+#define s28_tools_tls_net_h
+
+// Socket helpers shared by the host TLS tools.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "probe_engine.h"
+
+namespace s28 {
+namespace net {
+
+inline double now_ms(clockid_t clock = CLOCK_MONOTONIC) {
+  timespec ts;
+  clock_gettime(clock, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+inline void set_nonblocking(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// Blocking connect (as in snippets/client_get_fingerprint.c); -1 on error.
+inline int host_connect(const char *host, const char *port) {
+  addrinfo hints, *ai;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(host, port, &hints, &ai) != 0) {
+    return -1;
+  }
+  int fd = -1;
+  for (addrinfo *p = ai; p; p = p->ai_next) {
+    fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (connect(fd, p->ai_addr, p->ai_addrlen) == 0) {
+      break;
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(ai);
+  return fd;
+}
+
+// probe::Transport over a non-blocking socket
+struct SocketTransport : public probe::Transport {
+  explicit SocketTransport(int fd) : fd(fd) {}
+
+  int read(unsigned char *buf, size_t len) override {
+    ssize_t n = recv(fd, buf, len, 0);
+    if (n < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+    }
+    return n == 0 ? -1 : int(n);
+  }
+
+  int write(const unsigned char *buf, size_t len) override {
+    ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+    if (n < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+    }
+    return int(n);
+  }
+
+  int fd;
+};
+
+} // namespace net
+} // namespace s28
+
+#endif
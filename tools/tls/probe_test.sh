@@ -0,0 +1,29 @@
+#!/bin/sh
+# Probes a throwaway local TLS server (openssl s_server) with probe_time and
+# checks the fingerprint against the one openssl computes.
+#   ./probe_test.sh [RUNS] [PORT]
+set -e
+
+RUNS=${1:-20}
+PORT=${2:-19443}
+DIR=$(mktemp -d)
+trap 'kill $SERVER 2>/dev/null; rm -rf "$DIR"' EXIT
+
+openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes \
+  -subj /CN=localhost -days 1 -keyout "$DIR/key.pem" -out "$DIR/cert.pem" \
+  2>/dev/null
+openssl s_server -quiet -www -accept "$PORT" -cert "$DIR/cert.pem" \
+  -key "$DIR/key.pem" >/dev/null 2>&1 &
+SERVER=$!
+sleep 0.5
+
+EXPECTED=$(openssl x509 -noout -fingerprint -sha1 -in "$DIR/cert.pem" |
+  sed 's/.*=//; s/:/ /g')
+./probe_time 127.0.0.1 "$PORT" "$RUNS" | tee "$DIR/out"
+
+if grep -q "fingerprint $EXPECTED" "$DIR/out"; then
+  echo "fingerprint matches openssl: $EXPECTED"
+else
+  echo "fingerprint mismatch, expected $EXPECTED" >&2
+  exit 1
+fi
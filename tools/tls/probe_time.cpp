@@ -0,0 +1,93 @@
+// Runs the firmware's fingerprint probe (src/probe_engine.cpp) against a
+// server over a non-blocking socket and reports how long it takes.
+//   ./probe_time HOST PORT [RUNS]
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "net.h"
+#include "probe_engine.h"
+
+using namespace s28;
+using net::now_ms;
+
+namespace {
+
+const char *status_name(probe::Status s) {
+  switch (s) {
+  case probe::PENDING:
+    return "pending";
+  case probe::OK:
+    return "ok";
+  case probe::FAILED:
+    return "failed";
+  case probe::TIMEOUT:
+    return "timeout";
+  }
+  return "?";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s HOST PORT [RUNS]\n", argv[0]);
+    return 2;
+  }
+  int runs = argc > 3 ? atoi(argv[3]) : 1;
+  double total = 0, best = 1e12, worst = 0;
+  int failures = 0;
+  static probe::Engine engine; // ~4 KB, as on the device
+
+  for (int i = 0; i < runs; ++i) {
+    double start = now_ms();
+    double cpu_start = now_ms(CLOCK_PROCESS_CPUTIME_ID);
+    int fd = net::host_connect(argv[1], argv[2]);
+    if (fd < 0) {
+      fprintf(stderr, "connect to %s:%s failed\n", argv[1], argv[2]);
+      return 1;
+    }
+    net::set_nonblocking(fd);
+    double connected = now_ms();
+
+    uint8_t fp[20];
+    net::SocketTransport transport(fd);
+    engine.start(argv[1], fp, uint32_t(connected), 5000);
+    probe::Status s;
+    int steps = 0;
+    while ((s = engine.step(transport, uint32_t(now_ms()))) ==
+           probe::PENDING) {
+      pollfd pfd = {fd, POLLIN, 0};
+      poll(&pfd, 1, 50);
+      ++steps;
+    }
+    close(fd);
+
+    double elapsed = now_ms() - start;
+    double cpu = now_ms(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    printf("run %d: %s in %.2f ms (connect %.2f ms), cpu %.2f ms, %d steps, "
+           "%u bytes in, %u out",
+           i + 1, status_name(s), elapsed, connected - start, cpu, steps,
+           unsigned(engine.bytes_in), unsigned(engine.bytes_out));
+    if (s != probe::OK) {
+      printf(", error %d\n", engine.last_error());
+      ++failures;
+      continue;
+    }
+    printf(", fingerprint");
+    for (uint8_t b : fp) {
+      printf(" %02X", b);
+    }
+    printf("\n");
+    total += elapsed;
+    best = elapsed < best ? elapsed : best;
+    worst = elapsed > worst ? elapsed : worst;
+  }
+
+  if (runs > failures) {
+    printf("probe time: min %.2f ms, avg %.2f ms, max %.2f ms (%d/%d ok)\n",
+           best, total / (runs - failures), worst, runs - failures, runs);
+  }
+  return failures ? 1 : 0;
+}